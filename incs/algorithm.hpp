@@ -0,0 +1,297 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   algorithm.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/23 14:26:37 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/23 14:26:37 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ALGORITHM_HPP
+# define ALGORITHM_HPP
+
+# include <stddef.h>
+# include "type_traits.hpp"
+# include "simd.hpp"
+# include "vector_iterators.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Returns an iterator to the first element in [first,last) that
+	 * compares equal to val, or last if there is none.
+	*/
+	template <class InputIterator, class T>
+	InputIterator	find(InputIterator first, InputIterator last, const T& val)
+	{
+		while (first != last && !(*first == val))
+			++first;
+		return (first);
+	}
+
+	/**
+	 * @brief Returns an iterator to the first element in [first,last) for
+	 * which pred returns true, or last if there is none.
+	*/
+	template <class InputIterator, class UnaryPredicate>
+	InputIterator	find_if(InputIterator first, InputIterator last,
+		UnaryPredicate pred)
+	{
+		while (first != last && !pred(*first))
+			++first;
+		return (first);
+	}
+
+	/**
+	 * @brief Returns the number of elements in [first,last) that compare
+	 * equal to val.
+	*/
+	template <class InputIterator, class T>
+	ptrdiff_t	count(InputIterator first, InputIterator last, const T& val)
+	{
+		ptrdiff_t	n = 0;
+
+		for (; first != last; ++first)
+			if (*first == val)
+				n++;
+		return (n);
+	}
+
+	/**
+	 * @brief Returns the number of elements in [first,last) for which pred
+	 * returns true.
+	*/
+	template <class InputIterator, class UnaryPredicate>
+	ptrdiff_t	count_if(InputIterator first, InputIterator last,
+		UnaryPredicate pred)
+	{
+		ptrdiff_t	n = 0;
+
+		for (; first != last; ++first)
+			if (pred(*first))
+				n++;
+		return (n);
+	}
+
+	/**
+	 * @brief Tells whether an element of [first,last) compares equal to val.
+	*/
+	template <class InputIterator, class T>
+	bool	contains(InputIterator first, InputIterator last, const T& val)
+	{
+		return (ft::find(first, last, val) != last);
+	}
+
+	/**
+	 * @brief Returns an iterator to the first smallest element in
+	 * [first,last), or last if the range is empty.
+	*/
+	template <class ForwardIterator>
+	ForwardIterator	min_element(ForwardIterator first, ForwardIterator last)
+	{
+		ForwardIterator	best = first;
+
+		if (first == last)
+			return (last);
+		while (++first != last)
+			if (*first < *best)
+				best = first;
+		return (best);
+	}
+
+	template <class ForwardIterator, class Compare>
+	ForwardIterator	min_element(ForwardIterator first, ForwardIterator last,
+		Compare comp)
+	{
+		ForwardIterator	best = first;
+
+		if (first == last)
+			return (last);
+		while (++first != last)
+			if (comp(*first, *best))
+				best = first;
+		return (best);
+	}
+
+	/**
+	 * @brief Returns an iterator to the first greatest element in
+	 * [first,last), or last if the range is empty.
+	*/
+	template <class ForwardIterator>
+	ForwardIterator	max_element(ForwardIterator first, ForwardIterator last)
+	{
+		ForwardIterator	best = first;
+
+		if (first == last)
+			return (last);
+		while (++first != last)
+			if (*best < *first)
+				best = first;
+		return (best);
+	}
+
+	template <class ForwardIterator, class Compare>
+	ForwardIterator	max_element(ForwardIterator first, ForwardIterator last,
+		Compare comp)
+	{
+		ForwardIterator	best = first;
+
+		if (first == last)
+			return (last);
+		while (++first != last)
+			if (comp(*best, *first))
+				best = first;
+		return (best);
+	}
+
+/*
+** ---------------------------- VECTOR ITERATORS -------------------------------
+*/
+
+	/*
+	** Over vector iterators the elements are contiguous, so when they are
+	** integral, float or double the searches run the SSE4.1/AVX2 kernels of
+	** simd.hpp, picked at run time, with a scalar fallback. Other element
+	** types, and values of a type other than the elements', use the generic
+	** versions above.
+	*/
+
+	template <class Iterator, class T>
+	Iterator	contiguous_find(Iterator first, Iterator last, const T& val,
+		true_type)
+	{
+		return (first + simd::find(first.operator->(), last - first, val));
+	}
+
+	template <class Iterator, class T>
+	Iterator	contiguous_find(Iterator first, Iterator last, const T& val,
+		false_type)
+	{
+		while (first != last && !(*first == val))
+			++first;
+		return (first);
+	}
+
+	template <class Iterator, class T>
+	ptrdiff_t	contiguous_count(Iterator first, Iterator last, const T& val,
+		true_type)
+	{
+		return (simd::count(first.operator->(), last - first, val));
+	}
+
+	template <class Iterator, class T>
+	ptrdiff_t	contiguous_count(Iterator first, Iterator last, const T& val,
+		false_type)
+	{
+		ptrdiff_t	n = 0;
+
+		for (; first != last; ++first)
+			if (*first == val)
+				n++;
+		return (n);
+	}
+
+	template <bool Max, class Iterator>
+	Iterator	contiguous_extreme(Iterator first, Iterator last, true_type)
+	{
+		if (first == last)
+			return (last);
+		return (first + simd::extreme<Max>(first.operator->(), last - first));
+	}
+
+	template <bool Max, class Iterator>
+	Iterator	contiguous_extreme(Iterator first, Iterator last, false_type)
+	{
+		Iterator	best = first;
+
+		if (first == last)
+			return (last);
+		while (++first != last)
+			if (Max ? *best < *first : *first < *best)
+				best = first;
+		return (best);
+	}
+
+	template <class T>
+	Vector_iterator<T>	find(Vector_iterator<T> first, Vector_iterator<T> last,
+		const T& val)
+	{
+		return (contiguous_find(first, last, val,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	Vector_const_iterator<T>	find(Vector_const_iterator<T> first,
+		Vector_const_iterator<T> last, const T& val)
+	{
+		return (contiguous_find(first, last, val,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	ptrdiff_t	count(Vector_iterator<T> first, Vector_iterator<T> last,
+		const T& val)
+	{
+		return (contiguous_count(first, last, val,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	ptrdiff_t	count(Vector_const_iterator<T> first,
+		Vector_const_iterator<T> last, const T& val)
+	{
+		return (contiguous_count(first, last, val,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	bool	contains(Vector_iterator<T> first, Vector_iterator<T> last,
+		const T& val)
+	{
+		return (ft::find(first, last, val) != last);
+	}
+
+	template <class T>
+	bool	contains(Vector_const_iterator<T> first,
+		Vector_const_iterator<T> last, const T& val)
+	{
+		return (ft::find(first, last, val) != last);
+	}
+
+	template <class T>
+	Vector_iterator<T>	min_element(Vector_iterator<T> first,
+		Vector_iterator<T> last)
+	{
+		return (contiguous_extreme<false>(first, last,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	Vector_const_iterator<T>	min_element(Vector_const_iterator<T> first,
+		Vector_const_iterator<T> last)
+	{
+		return (contiguous_extreme<false>(first, last,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	Vector_iterator<T>	max_element(Vector_iterator<T> first,
+		Vector_iterator<T> last)
+	{
+		return (contiguous_extreme<true>(first, last,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+
+	template <class T>
+	Vector_const_iterator<T>	max_element(Vector_const_iterator<T> first,
+		Vector_const_iterator<T> last)
+	{
+		return (contiguous_extreme<true>(first, last,
+			bool_constant<simd::has_lanes<T>::value>()));
+	}
+}
+
+#endif /* ***************************************************** ALGORITHM_HPP */
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   atomic.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/12 14:02:17 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/12 14:02:17 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ATOMIC_HPP
+# define ATOMIC_HPP
+
+# include <stddef.h>
+# include <sched.h>
+
+/*
+** Size of a destructive interference range, used to pad indices that are
+** written by different threads so they never share a cache line.
+*/
+# ifndef FT_CACHELINE_SIZE
+#  define FT_CACHELINE_SIZE 64
+# endif
+
+namespace ft
+{
+	/**
+	 * @brief Memory ordering constraints, mapped on the GCC __atomic builtins
+	 * so they can be used from C++98 code.
+	*/
+	enum memory_order
+	{
+		memory_order_relaxed = __ATOMIC_RELAXED,
+		memory_order_consume = __ATOMIC_CONSUME,
+		memory_order_acquire = __ATOMIC_ACQUIRE,
+		memory_order_release = __ATOMIC_RELEASE,
+		memory_order_acq_rel = __ATOMIC_ACQ_REL,
+		memory_order_seq_cst = __ATOMIC_SEQ_CST
+	};
+
+	/**
+	 * @brief Minimal atomic wrapper for integral and pointer types. Every
+	 * operation defaults to sequential consistency, weaker orderings have to
+	 * be requested explicitly.
+	 * @tparam T Integral or pointer type, at most the size of a machine word.
+	*/
+	template <class T>
+	class atomic
+	{
+		private:
+
+			T		_val;
+
+			atomic(const atomic&);
+			atomic& operator=(const atomic&);
+
+		public:
+
+			explicit atomic(T val = T()) : _val(val) {}
+			~atomic() {}
+
+			/**
+			 * @brief Atomically reads the stored value.
+			*/
+			T load(memory_order order = memory_order_seq_cst) const
+			{
+				return (__atomic_load_n(&_val, order));
+			}
+
+			/**
+			 * @brief Atomically replaces the stored value with val.
+			*/
+			void store(T val, memory_order order = memory_order_seq_cst)
+			{
+				__atomic_store_n(&_val, val, order);
+			}
+
+			/**
+			 * @brief Atomically replaces the stored value with val.
+			 * @return The value held before the call.
+			*/
+			T exchange(T val, memory_order order = memory_order_seq_cst)
+			{
+				return (__atomic_exchange_n(&_val, val, order));
+			}
+
+			/**
+			 * @brief Stores desired if the current value equals expected,
+			 * otherwise loads the current value into expected.
+			 * @return true if the value was replaced, false otherwise.
+			*/
+			bool compare_exchange(T& expected, T desired,
+				memory_order success = memory_order_seq_cst,
+				memory_order failure = memory_order_seq_cst)
+			{
+				return (__atomic_compare_exchange_n(&_val, &expected, desired,
+					false, success, failure));
+			}
+
+			/**
+			 * @brief Atomically adds n to the stored value.
+			 * @return The value held before the call.
+			*/
+			T fetch_add(T n, memory_order order = memory_order_seq_cst)
+			{
+				return (__atomic_fetch_add(&_val, n, order));
+			}
+
+			/**
+			 * @brief Atomically subtracts n from the stored value.
+			 * @return The value held before the call.
+			*/
+			T fetch_sub(T n, memory_order order = memory_order_seq_cst)
+			{
+				return (__atomic_fetch_sub(&_val, n, order));
+			}
+	};
+
+	/**
+	 * @brief Hints the processor that the caller is busy-waiting, then yields
+	 * the time slice once the wait lasted long enough.
+	 * @param spins Number of iterations already spent waiting, increased by
+	 * the call.
+	*/
+	inline void	cpu_relax(unsigned& spins)
+	{
+		if (++spins < 64)
+		{
+# if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+# endif
+		}
+		else
+			sched_yield();
+	}
+}
+
+#endif /* ******************************************************** ATOMIC_HPP */
@@ -0,0 +1,458 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   concurrent_map.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/13 10:46:22 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/13 10:46:22 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONCURRENT_MAP_HPP
+# define CONCURRENT_MAP_HPP
+
+# include <new>
+# include <stdint.h>
+# include <string>
+# include <memory>
+# include <functional>
+# include "utils.hpp"
+# include "map.hpp"
+# include "vector.hpp"
+# include "priority_queue.hpp"
+# include "atomic.hpp"
+# include "mutex.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Finalizer scrambling the bits of h, so that keys differing only
+	 * in their high bits still end up in different shards. It is computed on
+	 * 64 bits and truncated, so that it is also defined for a 32-bit size_t.
+	*/
+	inline size_t	hash_mix(size_t h)
+	{
+		uint64_t	x = h;
+
+		x ^= x >> 33;
+		x *= (static_cast<uint64_t>(0xff51afd7) << 32) | 0xed558ccd;
+		x ^= x >> 33;
+		x *= (static_cast<uint64_t>(0xc4ceb9fe) << 32) | 0x1a85ec53;
+		x ^= x >> 33;
+		return (static_cast<size_t>(x));
+	}
+
+	/**
+	 * @brief Hash function object. Only integral, pointer and std::string
+	 * keys are provided, other key types need a user supplied Hash.
+	*/
+	template <class Key>
+	struct hash;
+
+	template <class T>
+	struct hash_integral
+	{
+		size_t operator()(T val) const
+		{
+			return (static_cast<size_t>(val));
+		}
+	};
+
+	template <> struct hash<bool> : public hash_integral<bool> {};
+	template <> struct hash<char> : public hash_integral<char> {};
+	template <> struct hash<signed char> : public hash_integral<signed char> {};
+	template <> struct hash<unsigned char> : public hash_integral<unsigned char> {};
+	template <> struct hash<short> : public hash_integral<short> {};
+	template <> struct hash<unsigned short> : public hash_integral<unsigned short> {};
+	template <> struct hash<int> : public hash_integral<int> {};
+	template <> struct hash<unsigned int> : public hash_integral<unsigned int> {};
+	template <> struct hash<long> : public hash_integral<long> {};
+	template <> struct hash<unsigned long> : public hash_integral<unsigned long> {};
+
+	template <class T>
+	struct hash<T*>
+	{
+		size_t operator()(T* ptr) const
+		{
+			return (reinterpret_cast<size_t>(ptr));
+		}
+	};
+
+	template <>
+	struct hash<std::string>
+	{
+		/**
+		 * @brief 64-bit FNV-1a over the characters of the string.
+		*/
+		size_t operator()(const std::string& str) const
+		{
+			uint64_t	h = (static_cast<uint64_t>(0xcbf29ce4) << 32) | 0x84222325;
+
+			for (std::string::size_type i = 0; i < str.size(); i++)
+			{
+				h ^= static_cast<unsigned char>(str[i]);
+				h *= (static_cast<uint64_t>(0x100) << 32) | 0x1b3;
+			}
+			return (static_cast<size_t>(h));
+		}
+	};
+
+	/**
+	 * @brief Concurrent maps split their elements across a fixed number of
+	 * shards, each one an ft::map guarded by its own reader-writer lock. A key
+	 * always lives in the shard selected by its hash, so operations on keys
+	 * of different shards never contend. Ordered traversal merges the shards.
+	 * @tparam Key Type of the keys.
+	 * @tparam T Type of the mapped value.
+	 * @tparam Compare A binary predicate that takes two element keys as
+	 * arguments and returns a bool.
+	 * @tparam Hash Unary function object returning a size_t for a key.
+	 * @tparam Alloc Type of the allocator object used by every shard.
+	*/
+	template <class Key, class T, class Compare = std::less<Key>,
+		class Hash = ft::hash<Key>,
+		class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class concurrent_map
+	{
+		public:
+
+			typedef Key									key_type;
+			typedef T									mapped_type;
+			typedef ft::pair<const key_type, mapped_type>	value_type;
+			typedef Compare								key_compare;
+			typedef Hash								hasher;
+			typedef Alloc								allocator_type;
+			typedef ft::map<Key, T, Compare, Alloc>		shard_type;
+			typedef size_t								size_type;
+
+		private:
+
+			/*
+			** Padded to a cache line so that the locks of neighbouring shards
+			** are not invalidated together.
+			*/
+			struct Shard
+			{
+				ft::shared_mutex	lock;
+				shard_type			map;
+				char				pad[FT_CACHELINE_SIZE];
+
+				Shard(const key_compare& comp, const allocator_type& alloc)
+				: map(comp, alloc) {}
+			};
+
+			typedef typename shard_type::const_iterator	shard_cursor;
+
+			/*
+			** Position of a shard during a merged traversal, ordered so that
+			** the priority queue's top is the cursor with the smallest key.
+			*/
+			struct Cursor
+			{
+				shard_cursor	head;
+				shard_cursor	end;
+
+				Cursor(shard_cursor h, shard_cursor e) : head(h), end(e) {}
+			};
+
+			struct Cursor_greater
+			{
+				key_compare		comp;
+
+				explicit Cursor_greater(const key_compare& c) : comp(c) {}
+				bool operator()(const Cursor& a, const Cursor& b) const
+				{
+					return (comp(b.head->first, a.head->first));
+				}
+			};
+
+			/**
+			 * @brief Locks every shard shared, in order, and unlocks the ones
+			 * it locked when destroyed, even if the traversal throws.
+			*/
+			class Shared_lock_all
+			{
+				private:
+
+					Shard*		m_shards;
+					size_type	m_locked;
+
+					Shared_lock_all(const Shared_lock_all&);
+					Shared_lock_all& operator=(const Shared_lock_all&);
+
+				public:
+
+					Shared_lock_all(Shard* shards, size_type count)
+					: m_shards(shards), m_locked(0)
+					{
+						for (; m_locked < count; m_locked++)
+							m_shards[m_locked].lock.lock_shared();
+					}
+					~Shared_lock_all()
+					{
+						while (m_locked > 0)
+							m_shards[--m_locked].lock.unlock_shared();
+					}
+			};
+
+			Shard*			_shards;
+			size_type		_mask;
+			key_compare		_comp;
+			hasher			_hash;
+
+			concurrent_map(const concurrent_map&);
+			concurrent_map& operator=(const concurrent_map&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty container.
+			 * @param shards Number of shards, rounded up to a power of two. It
+			 * should be a small multiple of the number of writer threads.
+			 * @param comp Key comparison object, copied into every shard.
+			 * @param hash Hash object selecting the shard of a key.
+			 * @param alloc Allocator object, copied into every shard.
+			*/
+			explicit concurrent_map(size_type shards = 16,
+				const key_compare& comp = key_compare(),
+				const hasher& hash = hasher(),
+				const allocator_type& alloc = allocator_type())
+			: _shards(NULL), _mask(1), _comp(comp), _hash(hash)
+			{
+				while (_mask < shards)
+					_mask <<= 1;
+				_shards = static_cast<Shard*>(::operator new(_mask * sizeof(Shard)));
+				for (size_type i = 0; i < _mask; i++)
+					new (&_shards[i]) Shard(comp, alloc);
+				_mask--;
+			}
+
+			~concurrent_map()
+			{
+				for (size_type i = 0; i <= _mask; i++)
+					_shards[i].~Shard();
+				::operator delete(_shards);
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			/**
+			 * @brief Returns the number of elements. Shards are counted one
+			 * after the other, so the result is only exact when no writer runs
+			 * concurrently.
+			*/
+			size_type size() const
+			{
+				size_type	total = 0;
+
+				for (size_type i = 0; i <= _mask; i++)
+				{
+					ft::shared_lock_guard<ft::shared_mutex>	guard(_shards[i].lock);
+					total += _shards[i].map.size();
+				}
+				return (total);
+			}
+
+			bool empty() const
+			{
+				return (this->size() == 0);
+			}
+
+			/**
+			 * @brief Returns the number of shards.
+			*/
+			size_type shard_count() const
+			{
+				return (_mask + 1);
+			}
+
+/*
+** -------------------------------- OPERATIONS ---------------------------------
+*/
+
+			/**
+			 * @brief Copies the value mapped to k into out, if any.
+			 * @return true if an element with key k was found.
+			*/
+			bool find(const key_type& k, mapped_type& out) const
+			{
+				Shard&	shard = this->shard_of(k);
+				ft::shared_lock_guard<ft::shared_mutex>	guard(shard.lock);
+				typename shard_type::const_iterator	it = shard.map.find(k);
+
+				if (it == shard.map.end())
+					return (false);
+				out = it->second;
+				return (true);
+			}
+
+			size_type count(const key_type& k) const
+			{
+				Shard&	shard = this->shard_of(k);
+				ft::shared_lock_guard<ft::shared_mutex>	guard(shard.lock);
+
+				return (shard.map.count(k));
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Inserts val unless an element with an equivalent key
+			 * already exists.
+			 * @return true if the element was inserted.
+			*/
+			bool insert(const value_type& val)
+			{
+				Shard&	shard = this->shard_of(val.first);
+				ft::lock_guard<ft::shared_mutex>	guard(shard.lock);
+
+				return (shard.map.insert(val).second);
+			}
+
+			/**
+			 * @brief Inserts val, or replaces the value mapped to its key.
+			 * @return true if a new element was inserted.
+			*/
+			bool insert_or_assign(const value_type& val)
+			{
+				Shard&	shard = this->shard_of(val.first);
+				ft::lock_guard<ft::shared_mutex>	guard(shard.lock);
+				size_type	before = shard.map.size();
+
+				shard.map[val.first] = val.second;
+				return (shard.map.size() != before);
+			}
+
+			/**
+			 * @brief Calls f on the value mapped to k while its shard is
+			 * locked, inserting a value-initialized element first if k is
+			 * missing. This is the read-modify-write path for counters.
+			 * @param f Function object taking a mapped_type&.
+			*/
+			template <class Function>
+			void update(const key_type& k, Function f)
+			{
+				Shard&	shard = this->shard_of(k);
+				ft::lock_guard<ft::shared_mutex>	guard(shard.lock);
+
+				f(shard.map[k]);
+			}
+
+			/**
+			 * @brief Removes the element with key k.
+			 * @return The number of elements erased.
+			*/
+			size_type erase(const key_type& k)
+			{
+				Shard&	shard = this->shard_of(k);
+				ft::lock_guard<ft::shared_mutex>	guard(shard.lock);
+
+				return (shard.map.erase(k));
+			}
+
+			void clear()
+			{
+				for (size_type i = 0; i <= _mask; i++)
+				{
+					ft::lock_guard<ft::shared_mutex>	guard(_shards[i].lock);
+					_shards[i].map.clear();
+				}
+			}
+
+/*
+** --------------------------------- TRAVERSAL ---------------------------------
+*/
+
+			/**
+			 * @brief Calls f on every shard in turn, each one being locked
+			 * exclusively for the duration of its call.
+			 * @param f Function object taking a shard_type&.
+			*/
+			template <class Function>
+			void for_each_shard(Function f)
+			{
+				for (size_type i = 0; i <= _mask; i++)
+				{
+					ft::lock_guard<ft::shared_mutex>	guard(_shards[i].lock);
+					f(_shards[i].map);
+				}
+			}
+
+			/**
+			 * @brief Calls f on every shard in turn, each one being locked
+			 * shared for the duration of its call.
+			 * @param f Function object taking a const shard_type&.
+			*/
+			template <class Function>
+			void for_each_shard(Function f) const
+			{
+				for (size_type i = 0; i <= _mask; i++)
+				{
+					ft::shared_lock_guard<ft::shared_mutex>	guard(_shards[i].lock);
+					f(static_cast<const shard_type&>(_shards[i].map));
+				}
+			}
+
+			/**
+			 * @brief Calls f on every element in key order. All shards are
+			 * locked shared for the whole traversal, which k-way merges them
+			 * through a heap of shard cursors, in O(n log shards). The locks
+			 * are released if f throws.
+			 * @param f Function object taking a const value_type&.
+			*/
+			template <class Function>
+			void for_each(Function f) const
+			{
+				Shared_lock_all	guard(_shards, _mask + 1);
+				ft::vector<Cursor>	cursors;
+
+				cursors.reserve(_mask + 1);
+				for (size_type i = 0; i <= _mask; i++)
+					if (!_shards[i].map.empty())
+						cursors.push_back(Cursor(_shards[i].map.begin(),
+							_shards[i].map.end()));
+
+				ft::priority_queue<Cursor, ft::vector<Cursor>, Cursor_greater>
+					heads(Cursor_greater(_comp), cursors);
+
+				while (!heads.empty())
+				{
+					Cursor	next = heads.top();
+
+					heads.pop();
+					f(*next.head);
+					if (++next.head != next.end)
+						heads.push(next);
+				}
+			}
+
+			key_compare key_comp() const
+			{
+				return (_comp);
+			}
+
+			hasher hash_function() const
+			{
+				return (_hash);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			Shard&	shard_of(const key_type& k) const
+			{
+				return (_shards[hash_mix(_hash(k)) & _mask]);
+			}
+	};
+}
+
+#endif /* ************************************************ CONCURRENT_MAP_HPP */
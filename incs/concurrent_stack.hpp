@@ -0,0 +1,324 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   concurrent_stack.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/15 11:03:48 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/15 11:03:48 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONCURRENT_STACK_HPP
+# define CONCURRENT_STACK_HPP
+
+# include <memory>
+# include <stdexcept>
+# include <stdint.h>
+# include "list.hpp"
+# include "atomic.hpp"
+# include "mutex.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Concurrent stacks are lock-free LIFO containers (Treiber stacks)
+	 * any number of threads can push to and pop from. Nodes come from a pool
+	 * owned by the stack and are addressed by a 32 bits index, which leaves
+	 * room for a 32 bits tag next to it in the 64 bits top word: every update
+	 * of the top bumps the tag, so a thread whose top was popped and pushed
+	 * back in the meantime (the ABA problem) fails its compare-and-swap.
+	 * Popped nodes are recycled through a second tagged stack, and pool
+	 * memory is only released with the container, so a stale index always
+	 * refers to a valid node.
+	 * @tparam T Type of the elements.
+	 * @tparam Alloc Type of the allocator object used for the pool.
+	*/
+	template <class T, class Alloc = std::allocator<T> >
+	class concurrent_stack
+	{
+		struct Node
+		{
+			ft::atomic<uint32_t>	next;
+			T						val;
+		};
+
+		public:
+
+			typedef T									value_type;
+			typedef Alloc								allocator_type;
+			typedef typename Alloc::template
+			rebind<Node>::other							Node_allocator;
+			typedef ft::list<T, Alloc>					list_type;
+			typedef size_t								size_type;
+
+		private:
+
+			/*
+			** The pool is made of chunks of geometrically increasing size, the
+			** k-th one holding (CHUNK_BASE << k) nodes, so an index maps to its
+			** chunk with a bit scan and the pool never moves a node.
+			*/
+			static const uint32_t	NIL = 0xffffffffu;
+			static const uint32_t	CHUNK_SHIFT = 6;
+			static const uint32_t	CHUNK_BASE = 1u << CHUNK_SHIFT;
+			static const uint32_t	MAX_CHUNKS = 25;
+
+			ft::atomic<uint64_t>	_top;
+			char					_pad0[FT_CACHELINE_SIZE];
+			ft::atomic<uint64_t>	_free;
+			ft::atomic<uint32_t>	_fresh;
+			char					_pad1[FT_CACHELINE_SIZE];
+			ft::atomic<Node*>		_chunks[MAX_CHUNKS];
+			ft::mutex				_grow;
+			allocator_type			_alloc;
+
+			concurrent_stack(const concurrent_stack&);
+			concurrent_stack& operator=(const concurrent_stack&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty stack.
+			 * @param alloc Allocator object.
+			*/
+			explicit concurrent_stack(const allocator_type& alloc = allocator_type())
+			: _top(make_word(0, NIL)), _free(make_word(0, NIL)), _fresh(0),
+				_alloc(alloc)
+			{
+				for (uint32_t k = 0; k < MAX_CHUNKS; k++)
+					_chunks[k].store(NULL, memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Destroys the remaining elements and releases the pool. No
+			 * thread may use the stack anymore.
+			*/
+			~concurrent_stack()
+			{
+				uint32_t	i = word_index(_top.load(memory_order_acquire));
+
+				for (; i != NIL; i = node_at(i).next.load(memory_order_relaxed))
+					_alloc.destroy(&node_at(i).val);
+				for (uint32_t k = 0; k < MAX_CHUNKS; k++)
+				{
+					Node*	chunk = _chunks[k].load(memory_order_relaxed);
+					if (chunk)
+						Node_allocator(_alloc).deallocate(chunk, CHUNK_BASE << k);
+				}
+			}
+
+			/**
+			 * @brief Returns whether the stack is empty. The answer may be
+			 * outdated on return if other threads use the stack.
+			*/
+			bool empty() const
+			{
+				return (word_index(_top.load(memory_order_acquire)) == NIL);
+			}
+
+			/**
+			 * @brief Inserts a copy of val on top of the stack.
+			 * @throw std::length_error if the pool is exhausted. If copying
+			 * val throws, its node goes back to the free list.
+			*/
+			void push(const value_type& val)
+			{
+				uint32_t	i = this->node_acquire();
+
+				try
+				{
+					_alloc.construct(&node_at(i).val, val);
+				}
+				catch (...)
+				{
+					this->link_push(_free, i);
+					throw;
+				}
+				this->link_push(_top, i);
+			}
+
+			/**
+			 * @brief Moves the top element of the stack into out, if any.
+			 * @return true if an element was popped, false if the stack was
+			 * empty.
+			 * @throw If copying the element into out throws, it is pushed
+			 * back on the stack.
+			*/
+			bool try_pop(value_type& out)
+			{
+				uint32_t	i = this->link_pop(_top);
+
+				if (i == NIL)
+					return (false);
+				try
+				{
+					out = node_at(i).val;
+				}
+				catch (...)
+				{
+					this->link_push(_top, i);
+					throw;
+				}
+				_alloc.destroy(&node_at(i).val);
+				this->link_push(_free, i);
+				return (true);
+			}
+
+			/**
+			 * @brief Detaches every element at once with a single exchange of
+			 * the top, then moves them into a list.
+			 * @return The popped elements, former top first.
+			 * @throw If copying an element into the list throws, the whole
+			 * detached chain is pushed back on the stack.
+			*/
+			list_type pop_all()
+			{
+				uint64_t	old = _top.load(memory_order_relaxed);
+				list_type	ret;
+
+				while (!_top.compare_exchange(old,
+					make_word(word_tag(old) + 1, NIL),
+					memory_order_acquire, memory_order_relaxed))
+					;
+				uint32_t	first = word_index(old);
+				try
+				{
+					for (uint32_t i = first; i != NIL;
+						i = node_at(i).next.load(memory_order_relaxed))
+						ret.push_back(node_at(i).val);
+				}
+				catch (...)
+				{
+					uint32_t	last = first;
+
+					while (node_at(last).next.load(memory_order_relaxed) != NIL)
+						last = node_at(last).next.load(memory_order_relaxed);
+					this->link_push(_top, first, last);
+					throw;
+				}
+				for (uint32_t i = first; i != NIL; )
+				{
+					Node&		node = node_at(i);
+					uint32_t	next = node.next.load(memory_order_relaxed);
+
+					_alloc.destroy(&node.val);
+					this->link_push(_free, i);
+					i = next;
+				}
+				return (ret);
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			static uint64_t	make_word(uint32_t tag, uint32_t index)
+			{
+				return ((static_cast<uint64_t>(tag) << 32) | index);
+			}
+
+			static uint32_t	word_tag(uint64_t word)
+			{
+				return (static_cast<uint32_t>(word >> 32));
+			}
+
+			static uint32_t	word_index(uint64_t word)
+			{
+				return (static_cast<uint32_t>(word));
+			}
+
+			static uint32_t	chunk_of(uint32_t i)
+			{
+				return (31 - __builtin_clz(i + CHUNK_BASE) - CHUNK_SHIFT);
+			}
+
+			Node&	node_at(uint32_t i) const
+			{
+				uint32_t	k = chunk_of(i);
+
+				return (_chunks[k].load(memory_order_acquire)
+					[i + CHUNK_BASE - (CHUNK_BASE << k)]);
+			}
+
+			/**
+			 * @brief Pushes node i on the given tagged stack.
+			*/
+			void	link_push(ft::atomic<uint64_t>& head, uint32_t i)
+			{
+				this->link_push(head, i, i);
+			}
+
+			/**
+			 * @brief Pushes the chain of nodes from first to last, linked
+			 * through their next index, on the given tagged stack.
+			*/
+			void	link_push(ft::atomic<uint64_t>& head, uint32_t first,
+				uint32_t last)
+			{
+				uint64_t	old = head.load(memory_order_relaxed);
+
+				do
+				{
+					node_at(last).next.store(word_index(old), memory_order_relaxed);
+				}
+				while (!head.compare_exchange(old,
+					make_word(word_tag(old) + 1, first),
+					memory_order_release, memory_order_relaxed));
+			}
+
+			/**
+			 * @brief Pops a node from the given tagged stack.
+			 * @return Its index, or NIL if the stack was empty.
+			*/
+			uint32_t	link_pop(ft::atomic<uint64_t>& head)
+			{
+				uint64_t	old = head.load(memory_order_acquire);
+
+				while (word_index(old) != NIL)
+				{
+					uint32_t	next = node_at(word_index(old))
+						.next.load(memory_order_relaxed);
+					if (head.compare_exchange(old,
+						make_word(word_tag(old) + 1, next),
+						memory_order_acquire, memory_order_acquire))
+						return (word_index(old));
+				}
+				return (NIL);
+			}
+
+			/**
+			 * @brief Takes a node from the free list, or a never used one from
+			 * the pool, allocating its chunk if needed.
+			*/
+			uint32_t	node_acquire()
+			{
+				uint32_t	i = this->link_pop(_free);
+
+				if (i != NIL)
+					return (i);
+				i = _fresh.fetch_add(1, memory_order_relaxed);
+				if (i >= (CHUNK_BASE << MAX_CHUNKS) - CHUNK_BASE)
+					throw std::length_error("concurrent_stack pool exhausted");
+				uint32_t	k = chunk_of(i);
+				if (_chunks[k].load(memory_order_acquire) == NULL)
+				{
+					ft::lock_guard<ft::mutex>	guard(_grow);
+					if (_chunks[k].load(memory_order_relaxed) == NULL)
+						_chunks[k].store(Node_allocator(_alloc)
+							.allocate(CHUNK_BASE << k), memory_order_release);
+				}
+				return (i);
+			}
+	};
+}
+
+#endif /* ********************************************** CONCURRENT_STACK_HPP */
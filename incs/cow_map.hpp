@@ -0,0 +1,742 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cow_map.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/12 15:10:04 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/12 15:10:04 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef COW_MAP_HPP
+# define COW_MAP_HPP
+
+# include <memory>
+# include <algorithm>
+# include <functional>
+# include <sched.h>
+# include "utils.hpp"
+# include "vector.hpp"
+# include "atomic.hpp"
+# include "mutex.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Copy-on-write maps are associative containers built on a
+	 * persistent AVL tree: a write never modifies a published node, it copies
+	 * the path from the root to the modified node and publishes the new root
+	 * atomically. Readers take a snapshot of the current root without locking
+	 * and traverse an immutable tree, any number of them can run concurrently
+	 * with a writer. Nodes are reference counted, so unchanged subtrees are
+	 * shared between versions and a version is reclaimed once the last
+	 * snapshot referring to it is released. Point reads do not take a
+	 * snapshot: they only announce themselves in a per-CPU counter, so they
+	 * write no cache line shared with readers on other CPUs.
+	 * @tparam Key Type of the keys. Each element is uniquely identified by its
+	 * key value.
+	 * @tparam T Type of the mapped value.
+	 * @tparam Compare A binary predicate that takes two element keys as
+	 * arguments and returns a bool.
+	 * @tparam Alloc Type of the allocator object used to define the storage
+	 * allocation model.
+	*/
+	template <class Key, class T, class Compare = std::less<Key>
+	, class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class cow_map
+	{
+		struct Node
+		{
+			ft::pair<const Key, T>	val;
+			Node*					left;
+			Node*					right;
+			int						height;
+			size_t					count;
+			size_t					version;
+			ft::atomic<size_t>		refs;
+		};
+
+		public:
+
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef ft::pair<const key_type, mapped_type>		value_type;
+			typedef Compare										key_compare;
+			typedef Alloc										allocator_type;
+			typedef typename Alloc::template
+			rebind<Node>::other									Node_allocator;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef ptrdiff_t									difference_type;
+			typedef size_t										size_type;
+
+			/**
+			 * @brief Immutable view of the map at the time it was taken. A
+			 * snapshot keeps its version alive and can be read from any thread
+			 * without synchronisation.
+			*/
+			class snapshot
+			{
+				friend class cow_map;
+
+				public:
+
+					/**
+					 * @brief Forward iterator walking the snapshot in key
+					 * order. It keeps the path to the current node, since
+					 * persistent nodes cannot point back to their parent.
+					*/
+					class const_iterator
+					{
+						public:
+
+							typedef typename cow_map::value_type	value_type;
+							typedef ptrdiff_t						difference_type;
+							typedef std::forward_iterator_tag		iterator_category;
+							typedef const value_type*				pointer;
+							typedef const value_type&				reference;
+
+						private:
+
+							ft::vector<Node*>	m_path;
+
+						public:
+
+							const_iterator() {}
+							explicit const_iterator(Node* root)
+							{
+								this->descend(root);
+							}
+							const_iterator(const const_iterator& from)
+							: m_path(from.m_path) {}
+							~const_iterator() {}
+
+							const_iterator& operator=(const const_iterator& it)
+							{
+								if (this != &it)
+									m_path = it.m_path;
+								return (*this);
+							}
+
+							bool operator==(const const_iterator& it) const
+							{
+								return (this->node() == it.node());
+							}
+							bool operator!=(const const_iterator& it) const
+							{
+								return (this->node() != it.node());
+							}
+							reference operator*() const { return (m_path.back()->val); }
+							pointer operator->() const { return (&(m_path.back()->val)); }
+							const_iterator& operator++()
+							{
+								Node* current = m_path.back();
+								m_path.pop_back();
+								this->descend(current->right);
+								return (*this);
+							}
+							const_iterator operator++(int)
+							{
+								const_iterator tmp(*this);
+								++(*this);
+								return (tmp);
+							}
+
+						private:
+
+							Node*	node() const
+							{
+								return (m_path.empty() ? NULL : m_path.back());
+							}
+
+							void	descend(Node* node)
+							{
+								for (; node != NULL; node = node->left)
+									m_path.push_back(node);
+							}
+					};
+
+				private:
+
+					Node*			_root;
+					key_compare		_comp;
+					allocator_type	_alloc;
+
+					snapshot(Node* root, const key_compare& comp,
+						const allocator_type& alloc)
+					: _root(root), _comp(comp), _alloc(alloc) {}
+
+				public:
+
+					snapshot(const snapshot& x)
+					: _root(x._root), _comp(x._comp), _alloc(x._alloc)
+					{
+						node_retain(_root);
+					}
+
+					~snapshot()
+					{
+						node_release(_root, _alloc);
+					}
+
+					snapshot& operator=(const snapshot& x)
+					{
+						node_retain(x._root);
+						node_release(_root, _alloc);
+						_root = x._root;
+						_comp = x._comp;
+						_alloc = x._alloc;
+						return (*this);
+					}
+
+					const_iterator begin() const
+					{
+						return (const_iterator(_root));
+					}
+
+					const_iterator end() const
+					{
+						return (const_iterator());
+					}
+
+					bool empty() const
+					{
+						return (_root == NULL);
+					}
+
+					size_type size() const
+					{
+						return (_root ? _root->count : 0);
+					}
+
+					/**
+					 * @brief Searches the snapshot for an element with a key
+					 * equivalent to k.
+					 * @return A pointer to the element, or NULL if no element
+					 * has this key. It stays valid as long as the snapshot.
+					*/
+					const_pointer find(const key_type& k) const
+					{
+						Node* node = tree_search(_root, k, _comp);
+
+						return (node ? &node->val : NULL);
+					}
+
+					size_type count(const key_type& k) const
+					{
+						return (tree_search(_root, k, _comp) ? 1 : 0);
+					}
+			};
+
+		private:
+
+			/*
+			** Readers register in the slot of the CPU they run on, in the
+			** counter of the epoch they observed. Each slot is aligned to and
+			** fills exactly one cache line, so that readers on different CPUs
+			** never write to the same line, nor to the line of _root and
+			** _epoch that every reader loads. The alignment only holds when
+			** the map itself is stored at its alignment: as a static or
+			** automatic object, or in memory obtained with posix_memalign.
+			*/
+			struct Reader_slot
+			{
+				ft::atomic<size_t>	readers[2];
+				char				pad[FT_CACHELINE_SIZE
+					- 2 * sizeof(ft::atomic<size_t>)];
+			} __attribute__((aligned(FT_CACHELINE_SIZE)));
+
+			static const size_type	reader_slots = 64;
+
+			/**
+			 * @brief Keeps the current root from being reclaimed while it is
+			 * alive. Unregisters from the counter it registered in, even if
+			 * the thread migrated to another CPU meanwhile.
+			*/
+			class Read_guard
+			{
+				private:
+
+					ft::atomic<size_t>	*m_readers;
+
+					Read_guard(const Read_guard&);
+					Read_guard& operator=(const Read_guard&);
+
+				public:
+
+					explicit Read_guard(const cow_map& map)
+					: m_readers(map.pin()) {}
+					~Read_guard()
+					{
+						m_readers->fetch_sub(1, memory_order_release);
+					}
+			};
+
+			ft::atomic<Node*>		_root;
+			ft::atomic<unsigned>	_epoch;
+			mutable Reader_slot		_slots[reader_slots];
+			ft::vector<Node*>		_retired[2];
+			size_t					_version;
+			ft::mutex				_writer;
+			key_compare				_comp;
+			allocator_type			_alloc;
+
+			cow_map(const cow_map&);
+			cow_map& operator=(const cow_map&);
+
+		public:
+
+			/**
+			 * @brief empty container constructor (default constructor):
+			 * Constructs an empty container, with no elements.
+			 * @param comp Binary predicate that, taking two element keys as
+			 * argument, returns true if the first argument goes before the
+			 * second argument in the strict weak ordering it defines, and false
+			 * otherwise.
+			 * @param alloc Allocator object. The container keeps and uses an
+			 * internal copy of this allocator.
+			*/
+			explicit cow_map(const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type())
+			: _root(NULL), _epoch(0), _version(1), _comp(comp), _alloc(alloc) {}
+
+			/**
+			 * @brief Destroys the container. Snapshots taken from it remain
+			 * valid and free their own version when released.
+			*/
+			~cow_map()
+			{
+				node_release(_root.load(memory_order_acquire), _alloc);
+				this->reclaim(_retired[0]);
+				this->reclaim(_retired[1]);
+			}
+
+/*
+** ---------------------------------- READERS ----------------------------------
+*/
+
+			/**
+			 * @brief Takes a snapshot of the current version of the map. This
+			 * never blocks, even while a writer is publishing a new version.
+			 * @return An immutable view of the map.
+			*/
+			snapshot get_snapshot() const
+			{
+				Read_guard	guard(*this);
+				Node*		root = _root.load(memory_order_acquire);
+
+				node_retain(root);
+				return (snapshot(root, _comp, _alloc));
+			}
+
+			/**
+			 * @brief Copies the value mapped to k into out, if any. Unlike a
+			 * snapshot, this does not retain the root, so concurrent lookups
+			 * only write to the counter of their own CPU.
+			 * @return true if an element with key k was found.
+			*/
+			bool lookup(const key_type& k, mapped_type& out) const
+			{
+				Read_guard	guard(*this);
+				Node*		found = tree_search(_root.load(memory_order_acquire),
+					k, _comp);
+
+				if (found == NULL)
+					return (false);
+				out = found->val.second;
+				return (true);
+			}
+
+			size_type count(const key_type& k) const
+			{
+				Read_guard	guard(*this);
+
+				return (tree_search(_root.load(memory_order_acquire), k, _comp)
+					? 1 : 0);
+			}
+
+			size_type size() const
+			{
+				Read_guard	guard(*this);
+				Node*		root = _root.load(memory_order_acquire);
+
+				return (root ? root->count : 0);
+			}
+
+			bool empty() const
+			{
+				return (this->size() == 0);
+			}
+
+/*
+** ---------------------------------- WRITERS ----------------------------------
+*/
+
+			/**
+			 * @brief Inserts val unless an element with an equivalent key
+			 * already exists, then publishes the new version.
+			 * @return true if the element was inserted.
+			*/
+			bool insert(const value_type& val)
+			{
+				ft::lock_guard<ft::mutex>	guard(_writer);
+				Node*						root = _root.load(memory_order_relaxed);
+
+				if (tree_search(root, val.first, _comp))
+					return (false);
+				node_retain(root);
+				this->publish(this->tree_insert(root, val));
+				return (true);
+			}
+
+			/**
+			 * @brief Inserts val, or replaces the value mapped to its key, then
+			 * publishes the new version.
+			 * @return true if a new element was inserted, false if an existing
+			 * one was replaced.
+			*/
+			bool insert_or_assign(const value_type& val)
+			{
+				ft::lock_guard<ft::mutex>	guard(_writer);
+				Node*						root = _root.load(memory_order_relaxed);
+				bool						inserted;
+
+				inserted = (tree_search(root, val.first, _comp) == NULL);
+				node_retain(root);
+				this->publish(this->tree_insert(root, val));
+				return (inserted);
+			}
+
+			/**
+			 * @brief Removes the element with key k, then publishes the new
+			 * version.
+			 * @return The number of elements erased.
+			*/
+			size_type erase(const key_type& k)
+			{
+				ft::lock_guard<ft::mutex>	guard(_writer);
+				Node*						root = _root.load(memory_order_relaxed);
+
+				if (!tree_search(root, k, _comp))
+					return (0);
+				node_retain(root);
+				this->publish(this->tree_erase(root, k));
+				return (1);
+			}
+
+			/**
+			 * @brief Publishes an empty version. Live snapshots keep their
+			 * elements until they are released.
+			*/
+			void clear()
+			{
+				ft::lock_guard<ft::mutex>	guard(_writer);
+
+				this->publish(NULL);
+			}
+
+			key_compare key_comp() const
+			{
+				return (_comp);
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			/**
+			 * @brief Registers the calling thread as a reader of the current
+			 * root, in the slot of its CPU.
+			 * @return The counter to decrement once done reading.
+			*/
+			ft::atomic<size_t>*	pin() const
+			{
+				int				cpu = sched_getcpu();
+				Reader_slot&	slot = _slots[cpu < 0 ? 0 : cpu % reader_slots];
+
+				for (;;)
+				{
+					unsigned			epoch = _epoch.load();
+					ft::atomic<size_t>*	readers = &slot.readers[epoch & 1];
+
+					readers->fetch_add(1);
+					if (_epoch.load() == epoch)
+						return (readers);
+					readers->fetch_sub(1, memory_order_release);
+				}
+			}
+
+			/**
+			 * @brief Swaps in the new root and retires the old one, without
+			 * waiting for readers. A root retired during epoch e can only be
+			 * read by the readers of epochs e - 1 and e. The epoch advances
+			 * once the counters of epoch e - 1 are found empty, which new
+			 * readers can no longer join: the roots retired during epoch
+			 * e - 1 are then released, since the readers of e - 2 drained at
+			 * the previous advance. A reader stalled in a counter only delays
+			 * reclamation, writers never spin. The epoch store and the
+			 * counter loads are sequentially consistent, as are the reader's
+			 * increment and epoch check: either the reader sees the new epoch
+			 * and retries, or the writer sees its count.
+			*/
+			void	publish(Node* root)
+			{
+				unsigned	epoch = _epoch.load(memory_order_relaxed);
+				size_type	i;
+
+				_retired[epoch & 1].push_back(NULL);
+				_retired[epoch & 1].back() = _root.exchange(root);
+				_version++;
+				for (i = 0; i < reader_slots; i++)
+					if (_slots[i].readers[(epoch + 1) & 1].load() != 0)
+						return ;
+				this->reclaim(_retired[(epoch + 1) & 1]);
+				_epoch.store(epoch + 1);
+			}
+
+			void	reclaim(ft::vector<Node*>& retired)
+			{
+				for (size_type i = 0; i < retired.size(); i++)
+					node_release(retired[i], _alloc);
+				retired.clear();
+			}
+
+			static void	node_retain(Node* node)
+			{
+				if (node)
+					node->refs.fetch_add(1, memory_order_relaxed);
+			}
+
+			static void	node_release(Node* node, allocator_type& alloc)
+			{
+				if (node == NULL
+					|| node->refs.fetch_sub(1, memory_order_acq_rel) != 1)
+					return ;
+				node_release(node->left, alloc);
+				node_release(node->right, alloc);
+				alloc.destroy(&node->val);
+				Node_allocator(alloc).deallocate(node, 1);
+			}
+
+			static Node*	tree_search(Node* node, const key_type& key,
+				const key_compare& comp)
+			{
+				while (node != NULL)
+				{
+					if (comp(key, node->val.first))
+						node = node->left;
+					else if (comp(node->val.first, key))
+						node = node->right;
+					else
+						return (node);
+				}
+				return (NULL);
+			}
+
+			Node*	tree_create_node(const value_type& val, Node* left,
+				Node* right)
+			{
+				Node*	new_node = Node_allocator(_alloc).allocate(1);
+
+				_alloc.construct(&new_node->val, val);
+				new_node->left = left;
+				new_node->right = right;
+				new_node->version = _version;
+				new_node->refs.store(1, memory_order_relaxed);
+				this->tree_update(new_node);
+				return (new_node);
+			}
+
+			/**
+			 * @brief Returns a node of the version being written equivalent to
+			 * the given one. Nodes already created by this write are returned
+			 * as is, published ones are copied, the copy sharing their
+			 * children.
+			 * @param node Node the caller holds a reference to, the reference
+			 * is transferred to the returned node.
+			*/
+			Node*	tree_mutable(Node* node)
+			{
+				if (node->version == _version)
+					return (node);
+				node_retain(node->left);
+				node_retain(node->right);
+				Node*	copy = this->tree_create_node(node->val, node->left,
+					node->right);
+				node_release(node, _alloc);
+				return (copy);
+			}
+
+			int		tree_height(Node* node) const
+			{
+				if (node != NULL)
+					return (node->height);
+				return (0);
+			}
+
+			int		tree_getbalance(Node* node) const
+			{
+				if (node == NULL)
+					return (0);
+				return (tree_height(node->left) - tree_height(node->right));
+			}
+
+			void	tree_update(Node* node)
+			{
+				node->height = std::max(tree_height(node->left),
+					tree_height(node->right)) + 1;
+				node->count = 1 + (node->left ? node->left->count : 0)
+					+ (node->right ? node->right->count : 0);
+			}
+
+			/**
+			 * @brief Performs a Right-Right rotation of the given node.
+			 * @return The root of the new subtree.
+			*/
+			Node*	tree_rr_rotate(Node* node)
+			{
+				Node*	new_parent;
+
+				node = this->tree_mutable(node);
+				new_parent = this->tree_mutable(node->right);
+				node->right = new_parent->left;
+				new_parent->left = node;
+				this->tree_update(node);
+				this->tree_update(new_parent);
+				return (new_parent);
+			}
+
+			/**
+			 * @brief Performs a Left-Left rotation of the given node.
+			 * @return The root of the new subtree.
+			*/
+			Node*	tree_ll_rotate(Node* node)
+			{
+				Node*	new_parent;
+
+				node = this->tree_mutable(node);
+				new_parent = this->tree_mutable(node->left);
+				node->left = new_parent->right;
+				new_parent->right = node;
+				this->tree_update(node);
+				this->tree_update(new_parent);
+				return (new_parent);
+			}
+
+			/**
+			 * @brief Restores the AVL property on a node of the version being
+			 * written, whose subtrees are balanced.
+			 * @return The root of the balanced subtree.
+			*/
+			Node*	tree_balance(Node* node)
+			{
+				this->tree_update(node);
+				int	factor = tree_getbalance(node);
+				if (factor > 1)
+				{
+					if (tree_getbalance(node->left) < 0)
+						node->left = this->tree_rr_rotate(node->left);
+					return (this->tree_ll_rotate(node));
+				}
+				else if (factor < -1)
+				{
+					if (tree_getbalance(node->right) > 0)
+						node->right = this->tree_ll_rotate(node->right);
+					return (this->tree_rr_rotate(node));
+				}
+				return (node);
+			}
+
+			/**
+			 * @brief Inserts or replaces val in the given subtree, copying the
+			 * path to it.
+			 * @param node Subtree the caller holds a reference to, the
+			 * reference is transferred to the returned subtree.
+			 * @return The root of the new subtree.
+			*/
+			Node*	tree_insert(Node* node, const value_type& val)
+			{
+				if (node == NULL)
+					return (this->tree_create_node(val, NULL, NULL));
+				if (_comp(val.first, node->val.first))
+				{
+					node = this->tree_mutable(node);
+					node->left = this->tree_insert(node->left, val);
+				}
+				else if (_comp(node->val.first, val.first))
+				{
+					node = this->tree_mutable(node);
+					node->right = this->tree_insert(node->right, val);
+				}
+				else
+				{
+					node_retain(node->left);
+					node_retain(node->right);
+					Node*	replaced = this->tree_create_node(val, node->left,
+						node->right);
+					node_release(node, _alloc);
+					return (replaced);
+				}
+				return (this->tree_balance(node));
+			}
+
+			/**
+			 * @brief Removes the element with the given key, which must exist
+			 * in the subtree, copying the path to it.
+			 * @param node Subtree the caller holds a reference to, the
+			 * reference is transferred to the returned subtree.
+			 * @return The root of the new subtree.
+			*/
+			Node*	tree_erase(Node* node, const key_type& key)
+			{
+				if (_comp(key, node->val.first))
+				{
+					node = this->tree_mutable(node);
+					node->left = this->tree_erase(node->left, key);
+				}
+				else if (_comp(node->val.first, key))
+				{
+					node = this->tree_mutable(node);
+					node->right = this->tree_erase(node->right, key);
+				}
+				else if (node->left == NULL || node->right == NULL)
+				{
+					Node*	child = node->left ? node->left : node->right;
+
+					node_retain(child);
+					node_release(node, _alloc);
+					return (child);
+				}
+				else
+				{
+					Node*	next = node->right;
+
+					while (next->left != NULL)
+						next = next->left;
+					node_retain(node->left);
+					node_retain(node->right);
+					Node*	replaced = this->tree_create_node(next->val,
+						node->left, node->right);
+					node_release(node, _alloc);
+					node = replaced;
+					node->right = this->tree_erase(node->right, node->val.first);
+				}
+				return (this->tree_balance(node));
+			}
+	};
+
+	template <class Key, class T, class Compare, class Alloc>
+	const typename cow_map<Key,T,Compare,Alloc>::size_type
+		cow_map<Key,T,Compare,Alloc>::reader_slots;
+}
+
+#endif /* ******************************************************* COW_MAP_HPP */
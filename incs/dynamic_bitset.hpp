@@ -0,0 +1,995 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dynamic_bitset.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/28 11:02:47 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/28 11:02:47 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DYNAMIC_BITSET_HPP
+# define DYNAMIC_BITSET_HPP
+
+# include <stddef.h>
+# include <stdint.h>
+# include <algorithm>
+# include <iterator>
+# include <limits>
+# include <memory>
+# include <stdexcept>
+# include "simd.hpp"
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Reference to a single bit of a word, returned by the
+	 * subscript operators of dynamic_bitset and vector<bool>.
+	*/
+	class Bit_reference
+	{
+		private:
+
+			uint64_t	*m_word;
+			uint64_t	m_mask;
+
+		public:
+
+			Bit_reference(uint64_t* word, uint64_t mask)
+			: m_word(word), m_mask(mask) {}
+
+			operator bool() const { return ((*m_word & m_mask) != 0); }
+			bool operator~() const { return ((*m_word & m_mask) == 0); }
+
+			Bit_reference& operator=(bool x)
+			{
+				if (x)
+					*m_word |= m_mask;
+				else
+					*m_word &= ~m_mask;
+				return (*this);
+			}
+			Bit_reference& operator=(const Bit_reference& x)
+			{
+				return (*this = static_cast<bool>(x));
+			}
+
+			void flip() { *m_word ^= m_mask; }
+	};
+
+	class Bit_const_iterator;
+
+	/**
+	 * @brief Random access iterator over packed bits: the words and the
+	 * index of the bit. Dereferencing yields a Bit_reference.
+	*/
+	class Bit_iterator
+	{
+		public:
+
+			typedef bool							value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::random_access_iterator_tag	iterator_category;
+			typedef Bit_reference					reference;
+			typedef void							pointer;
+
+		protected:
+
+			uint64_t	*m_words;
+			size_t		m_index;
+
+		private:
+
+			Bit_iterator(const Bit_const_iterator& );
+
+		public:
+
+			Bit_iterator(uint64_t* words = NULL, size_t index = 0)
+			: m_words(words), m_index(index) {}
+			Bit_iterator(const Bit_iterator& from)
+			: m_words(from.m_words), m_index(from.m_index) {}
+			~Bit_iterator() {}
+
+			uint64_t*	getWords() const { return m_words; }
+			size_t		getIndex() const { return m_index; }
+			Bit_iterator& operator=(const Bit_iterator& it)
+			{
+				m_words = it.m_words;
+				m_index = it.m_index;
+				return (*this);
+			}
+
+			bool operator==(const Bit_iterator& it) const
+			{
+				return (m_index == it.m_index);
+			}
+			bool operator!=(const Bit_iterator& it) const
+			{
+				return (m_index != it.m_index);
+			}
+			reference operator*() const
+			{
+				return (reference(m_words + m_index / 64,
+					static_cast<uint64_t>(1) << (m_index % 64)));
+			}
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+			Bit_iterator& operator++()
+			{
+				m_index++;
+				return (*this);
+			}
+			Bit_iterator operator++(int)
+			{
+				Bit_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Bit_iterator& operator--()
+			{
+				m_index--;
+				return (*this);
+			}
+			Bit_iterator operator--(int)
+			{
+				Bit_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+			Bit_iterator operator+(difference_type n) const
+			{
+				return (Bit_iterator(m_words, m_index + n));
+			}
+			Bit_iterator operator-(difference_type n) const
+			{
+				return (Bit_iterator(m_words, m_index - n));
+			}
+			difference_type operator-(const Bit_iterator& other) const
+			{
+				return (static_cast<difference_type>(m_index - other.m_index));
+			}
+			friend Bit_iterator operator+(difference_type n,
+				const Bit_iterator& other)
+			{
+				return (other.operator+(n));
+			}
+			Bit_iterator& operator+=(difference_type n)
+			{
+				m_index += n;
+				return (*this);
+			}
+			Bit_iterator& operator-=(difference_type n)
+			{
+				m_index -= n;
+				return (*this);
+			}
+			bool operator<(const Bit_iterator& other) const
+			{
+				return (m_index < other.m_index);
+			}
+			bool operator>(const Bit_iterator& other) const
+			{
+				return (m_index > other.m_index);
+			}
+			bool operator<=(const Bit_iterator& other) const
+			{
+				return (m_index <= other.m_index);
+			}
+			bool operator>=(const Bit_iterator& other) const
+			{
+				return (m_index >= other.m_index);
+			}
+	};
+
+	class Bit_const_iterator : public Bit_iterator
+	{
+		public:
+
+			typedef bool	reference;
+			typedef bool	const_reference;
+
+			Bit_const_iterator(const uint64_t* words = NULL, size_t index = 0)
+			: Bit_iterator(const_cast<uint64_t*>(words), index) {}
+			Bit_const_iterator(const Bit_iterator& from)
+			: Bit_iterator(from.getWords(), from.getIndex()) {}
+
+			Bit_const_iterator& operator=(const Bit_const_iterator& it)
+			{
+				Bit_iterator::operator=(it);
+				return (*this);
+			}
+			const_reference operator*() const
+			{
+				return ((m_words[m_index / 64] >> (m_index % 64)) & 1);
+			}
+			const_reference operator[](difference_type n) const
+			{
+				return (*Bit_const_iterator(m_words, m_index + n));
+			}
+	};
+
+	/**
+	 * @brief Resizable sequence of bits packed into 64-bit words, eight
+	 * times smaller than one bool per byte. Counting the bits set runs the
+	 * popcnt or AVX2 kernels of simd.hpp, searching skips whole words of
+	 * zeros, and the bitwise operators combine whole buffers with SSE2 or
+	 * AVX2. The bits past size() in the last word are kept cleared, so
+	 * that whole-word operations never see them.
+	 * @tparam Alloc Type of the allocator object used for the words.
+	 * @tparam Growth Growth policy of the underlying vector of words.
+	*/
+	template <class Alloc = std::allocator<uint64_t>,
+		class Growth = growth_double>
+	class dynamic_bitset
+	{
+		public:
+
+			typedef uint64_t			block_type;
+			typedef Alloc				allocator_type;
+			typedef size_t				size_type;
+			typedef bool				value_type;
+			typedef Bit_reference		reference;
+			typedef bool				const_reference;
+			typedef Bit_iterator		iterator;
+			typedef Bit_const_iterator	const_iterator;
+
+			static const size_type	bits_per_block = 64;
+			static const size_type	npos = static_cast<size_type>(-1);
+
+		private:
+
+			ft::vector<block_type, Alloc, Growth>	_words;
+			size_type								_size;
+
+		public:
+
+			/**
+			 * @brief Constructs a bitset of n bits, all set to value.
+			*/
+			explicit dynamic_bitset(size_type n = 0, bool value = false,
+				const allocator_type& alloc = allocator_type())
+			: _words(alloc), _size(0)
+			{
+				this->resize(n, value);
+			}
+
+			dynamic_bitset(const dynamic_bitset& x)
+			: _words(x._words), _size(x._size) {}
+
+			~dynamic_bitset() {}
+
+			dynamic_bitset& operator=(const dynamic_bitset& x)
+			{
+				_words = x._words;
+				_size = x._size;
+				return (*this);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(this->words(), 0)); }
+			const_iterator begin() const { return (const_iterator(this->data(), 0)); }
+			iterator end() { return (iterator(this->words(), _size)); }
+			const_iterator end() const { return (const_iterator(this->data(), _size)); }
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_size == 0); }
+			size_type size() const { return (_size); }
+			size_type num_blocks() const { return (_words.size()); }
+			size_type capacity() const { return (_words.capacity() * bits_per_block); }
+			size_type max_size() const { return (_words.max_size() * bits_per_block); }
+
+			void reserve(size_type n)
+			{
+				_words.reserve(blocks_for(n));
+			}
+
+			/**
+			 * @brief Resizes the bitset to n bits, the new ones set to value.
+			*/
+			void resize(size_type n, bool value = false)
+			{
+				size_type	old = _size;
+
+				_words.resize(blocks_for(n), value ? ~static_cast<block_type>(0) : 0);
+				if (value && n > old && old % bits_per_block)
+					_words[old / bits_per_block] |= ~static_cast<block_type>(0)
+						<< (old % bits_per_block);
+				_size = n;
+				this->clear_unused();
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type pos)
+			{
+				return (reference(this->words() + pos / bits_per_block, mask(pos)));
+			}
+			const_reference operator[](size_type pos) const
+			{
+				return ((_words[pos / bits_per_block] & mask(pos)) != 0);
+			}
+
+			/**
+			 * @brief Returns the bit at pos.
+			 * @throw std::out_of_range if pos is not a valid position.
+			*/
+			bool test(size_type pos) const
+			{
+				if (pos >= _size)
+					throw std::out_of_range("dynamic_bitset::test");
+				return ((*this)[pos]);
+			}
+
+			/**
+			 * @brief Returns the words holding the bits, bit i being bit
+			 * i % 64 of word i / 64.
+			*/
+			const block_type* data() const
+			{
+				return (_words.empty() ? NULL : &_words[0]);
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			void push_back(bool value)
+			{
+				if (_size % bits_per_block == 0)
+					_words.push_back(0);
+				_size++;
+				(*this)[_size - 1] = value;
+			}
+
+			/**
+			 * @brief Appends the 64 bits of block, its lowest bit first.
+			*/
+			void append(block_type block)
+			{
+				size_type	off = _size % bits_per_block;
+
+				if (off == 0)
+					_words.push_back(block);
+				else
+				{
+					_words.push_back(block >> (bits_per_block - off));
+					_words[_words.size() - 2] |= block << off;
+				}
+				_size += bits_per_block;
+			}
+
+			/**
+			 * @brief Appends the blocks of [first,last), in order.
+			*/
+			template <class BlockInputIterator>
+			void append(BlockInputIterator first, BlockInputIterator last)
+			{
+				for (; first != last; ++first)
+					this->append(static_cast<block_type>(*first));
+			}
+
+			void pop_back()
+			{
+				_size--;
+				if (_size % bits_per_block == 0)
+					_words.pop_back();
+				else
+					this->clear_unused();
+			}
+
+			void clear()
+			{
+				_words.clear();
+				_size = 0;
+			}
+
+			dynamic_bitset& set(size_type pos, bool value = true)
+			{
+				(*this)[pos] = value;
+				return (*this);
+			}
+
+			dynamic_bitset& set()
+			{
+				for (size_type i = 0; i < _words.size(); i++)
+					_words[i] = ~static_cast<block_type>(0);
+				this->clear_unused();
+				return (*this);
+			}
+
+			dynamic_bitset& reset(size_type pos)
+			{
+				return (this->set(pos, false));
+			}
+
+			dynamic_bitset& reset()
+			{
+				for (size_type i = 0; i < _words.size(); i++)
+					_words[i] = 0;
+				return (*this);
+			}
+
+			dynamic_bitset& flip(size_type pos)
+			{
+				_words[pos / bits_per_block] ^= mask(pos);
+				return (*this);
+			}
+
+			dynamic_bitset& flip()
+			{
+				for (size_type i = 0; i < _words.size(); i++)
+					_words[i] = ~_words[i];
+				this->clear_unused();
+				return (*this);
+			}
+
+			/**
+			 * @brief Inserts n bits set to value before pos, shifting the
+			 * following bits up a word at a time.
+			*/
+			void insert(size_type pos, size_type n, bool value)
+			{
+				size_type	end = _size;
+				size_type	len;
+
+				this->resize(_size + n);
+				for (; end > pos; end -= len)
+				{
+					len = std::min(end - pos, bits_per_block);
+					this->set_bits(end - len + n, len, this->get_bits(end - len));
+				}
+				for (size_type i = pos; i < pos + n; i += len)
+				{
+					len = std::min(pos + n - i, bits_per_block);
+					this->set_bits(i, len, value ? ~static_cast<block_type>(0) : 0);
+				}
+			}
+
+			/**
+			 * @brief Removes the n bits from pos, shifting the following bits
+			 * down a word at a time.
+			*/
+			void erase(size_type pos, size_type n)
+			{
+				size_type	len;
+
+				for (size_type i = pos; i + n < _size; i += len)
+				{
+					len = std::min(_size - n - i, bits_per_block);
+					this->set_bits(i, len, this->get_bits(i + n));
+				}
+				this->resize(_size - n);
+			}
+
+			void swap(dynamic_bitset& x)
+			{
+				size_type	tmp = _size;
+
+				_words.swap(x._words);
+				_size = x._size;
+				x._size = tmp;
+			}
+
+/*
+** --------------------------------- BITWISE -----------------------------------
+*/
+
+			/*
+			** The operands of the bitwise operators must have the same size.
+			*/
+
+			dynamic_bitset& operator&=(const dynamic_bitset& x)
+			{
+				return (this->apply<simd::op_and>(x));
+			}
+
+			dynamic_bitset& operator|=(const dynamic_bitset& x)
+			{
+				return (this->apply<simd::op_or>(x));
+			}
+
+			dynamic_bitset& operator^=(const dynamic_bitset& x)
+			{
+				return (this->apply<simd::op_xor>(x));
+			}
+
+			/**
+			 * @brief Clears the bits set in x.
+			*/
+			dynamic_bitset& operator-=(const dynamic_bitset& x)
+			{
+				return (this->apply<simd::op_andnot>(x));
+			}
+
+			dynamic_bitset operator~() const
+			{
+				dynamic_bitset	tmp(*this);
+
+				return (tmp.flip());
+			}
+
+/*
+** -------------------------------- OPERATIONS ---------------------------------
+*/
+
+			/**
+			 * @brief Returns the number of bits set.
+			*/
+			size_type count() const
+			{
+				return (simd::popcount(this->data(), _words.size()));
+			}
+
+			bool any() const
+			{
+				for (size_type i = 0; i < _words.size(); i++)
+					if (_words[i])
+						return (true);
+				return (false);
+			}
+
+			bool none() const { return (!this->any()); }
+
+			bool all() const
+			{
+				return (this->count() == _size);
+			}
+
+			/**
+			 * @brief Returns the position of the first bit set, or npos.
+			*/
+			size_type find_first() const
+			{
+				return (this->find_from(0, ~static_cast<block_type>(0)));
+			}
+
+			/**
+			 * @brief Returns the position of the first bit set after pos, or
+			 * npos.
+			*/
+			size_type find_next(size_type pos) const
+			{
+				if (++pos >= _size)
+					return (npos);
+				return (this->find_from(pos / bits_per_block,
+					~static_cast<block_type>(0) << (pos % bits_per_block)));
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (_words.get_allocator());
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			static size_type blocks_for(size_type n)
+			{
+				return ((n + bits_per_block - 1) / bits_per_block);
+			}
+
+			static block_type mask(size_type pos)
+			{
+				return (static_cast<block_type>(1) << (pos % bits_per_block));
+			}
+
+			block_type* words()
+			{
+				return (_words.empty() ? NULL : &_words[0]);
+			}
+
+			/**
+			 * @brief Returns the bits from pos up, bit pos being the lowest,
+			 * as many as are left in the words up to 64.
+			*/
+			block_type get_bits(size_type pos) const
+			{
+				size_type	w = pos / bits_per_block;
+				size_type	off = pos % bits_per_block;
+				block_type	bits = _words[w] >> off;
+
+				if (off && w + 1 < _words.size())
+					bits |= _words[w + 1] << (bits_per_block - off);
+				return (bits);
+			}
+
+			/**
+			 * @brief Overwrites the len bits from pos, len being at most 64,
+			 * with the low bits of bits.
+			*/
+			void set_bits(size_type pos, size_type len, block_type bits)
+			{
+				size_type	w = pos / bits_per_block;
+				size_type	off = pos % bits_per_block;
+				block_type	keep = (len == bits_per_block ? ~static_cast<block_type>(0)
+					: (static_cast<block_type>(1) << len) - 1);
+
+				bits &= keep;
+				_words[w] = (_words[w] & ~(keep << off)) | (bits << off);
+				if (off + len > bits_per_block)
+					_words[w + 1] = (_words[w + 1] & ~(keep >> (bits_per_block - off)))
+						| (bits >> (bits_per_block - off));
+			}
+
+			/**
+			 * @brief Clears the bits of the last word past size().
+			*/
+			void clear_unused()
+			{
+				if (_size % bits_per_block)
+					_words.back() &= ~(~static_cast<block_type>(0)
+						<< (_size % bits_per_block));
+			}
+
+			/**
+			 * @brief Returns the first bit set from word w, ignoring the bits
+			 * of w outside first_mask, or npos.
+			*/
+			size_type find_from(size_type w, block_type first_mask) const
+			{
+				block_type	word;
+
+				if (w >= _words.size())
+					return (npos);
+				word = _words[w] & first_mask;
+				while (word == 0)
+				{
+					if (++w == _words.size())
+						return (npos);
+					word = _words[w];
+				}
+				return (w * bits_per_block + __builtin_ctzll(word));
+			}
+
+			template <class Op>
+			dynamic_bitset& apply(const dynamic_bitset& x)
+			{
+				if (x._size != _size)
+					throw std::invalid_argument("dynamic_bitset: size mismatch");
+				simd::bitwise<Op>(this->words(), x.data(), _words.size());
+				return (*this);
+			}
+	};
+
+	template <class Alloc, class Growth>
+	const typename dynamic_bitset<Alloc,Growth>::size_type
+		dynamic_bitset<Alloc,Growth>::bits_per_block;
+
+	template <class Alloc, class Growth>
+	const typename dynamic_bitset<Alloc,Growth>::size_type
+		dynamic_bitset<Alloc,Growth>::npos;
+
+/*
+** -------------------------------- OVERLOADS ----------------------------------
+*/
+
+	template <class Alloc, class Growth>
+	dynamic_bitset<Alloc,Growth> operator&(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		dynamic_bitset<Alloc,Growth>	tmp(lhs);
+
+		return (tmp &= rhs);
+	}
+
+	template <class Alloc, class Growth>
+	dynamic_bitset<Alloc,Growth> operator|(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		dynamic_bitset<Alloc,Growth>	tmp(lhs);
+
+		return (tmp |= rhs);
+	}
+
+	template <class Alloc, class Growth>
+	dynamic_bitset<Alloc,Growth> operator^(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		dynamic_bitset<Alloc,Growth>	tmp(lhs);
+
+		return (tmp ^= rhs);
+	}
+
+	template <class Alloc, class Growth>
+	dynamic_bitset<Alloc,Growth> operator-(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		dynamic_bitset<Alloc,Growth>	tmp(lhs);
+
+		return (tmp -= rhs);
+	}
+
+	template <class Alloc, class Growth>
+	bool operator==(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		return (lhs.size() == rhs.size() && simd::mismatch(lhs.data(),
+			rhs.data(), lhs.num_blocks() * sizeof(uint64_t))
+			== lhs.num_blocks() * sizeof(uint64_t));
+	}
+
+	template <class Alloc, class Growth>
+	bool operator!=(const dynamic_bitset<Alloc,Growth>& lhs,
+		const dynamic_bitset<Alloc,Growth>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Alloc, class Growth>
+	void swap(dynamic_bitset<Alloc,Growth>& x, dynamic_bitset<Alloc,Growth>& y)
+	{
+		x.swap(y);
+	}
+
+/*
+** ------------------------------- VECTOR<BOOL> --------------------------------
+*/
+
+	/**
+	 * @brief Specialisation of vector for bool, storing its elements as
+	 * bits in a dynamic_bitset: one bit per element instead of one byte.
+	 * As with std::vector<bool>, elements are not addressable: the
+	 * subscript operators and iterators yield Bit_reference proxies.
+	 * @tparam Alloc Allocator of bool, rebound to allocate the words.
+	 * @tparam Growth Growth policy of the underlying words.
+	*/
+	template <class Alloc, class Growth>
+	class vector<bool, Alloc, Growth>
+	{
+		typedef typename Alloc::template rebind<uint64_t>::other	word_allocator;
+		typedef dynamic_bitset<word_allocator, Growth>				bitset_type;
+
+		public:
+
+			typedef bool									value_type;
+			typedef Alloc									allocator_type;
+			typedef Growth									growth_policy;
+			typedef Bit_reference							reference;
+			typedef bool									const_reference;
+			typedef Bit_iterator							iterator;
+			typedef Bit_const_iterator						const_iterator;
+			typedef std::reverse_iterator<iterator>			reverse_iterator;
+			typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+			typedef ptrdiff_t								difference_type;
+			typedef size_t									size_type;
+
+		private:
+
+			bitset_type		_bits;
+			allocator_type	_alloc;
+
+		public:
+
+			explicit vector(const allocator_type& alloc = allocator_type())
+			: _bits(0, false, word_allocator(alloc)), _alloc(alloc) {}
+
+			explicit vector(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())
+			: _bits(n, val, word_allocator(alloc)), _alloc(alloc) {}
+
+			template <class InputIterator>
+			vector(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last,
+				const allocator_type& alloc = allocator_type())
+			: _bits(0, false, word_allocator(alloc)), _alloc(alloc)
+			{
+				for (; first != last; ++first)
+					_bits.push_back(*first);
+			}
+
+			vector(const vector& x) : _bits(x._bits), _alloc(x._alloc) {}
+
+			~vector() {}
+
+			vector& operator=(const vector& x)
+			{
+				_bits = x._bits;
+				return (*this);
+			}
+
+			template <class InputIterator>
+			void assign(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last)
+			{
+				_bits.clear();
+				for (; first != last; ++first)
+					_bits.push_back(*first);
+			}
+
+			void assign(size_type n, const value_type& val)
+			{
+				_bits.clear();
+				_bits.resize(n, val);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (_bits.begin()); }
+			const_iterator begin() const { return (_bits.begin()); }
+			iterator end() { return (_bits.end()); }
+			const_iterator end() const { return (_bits.end()); }
+			reverse_iterator rbegin() { return (reverse_iterator(this->end())); }
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(this->end()));
+			}
+			reverse_iterator rend() { return (reverse_iterator(this->begin())); }
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(this->begin()));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			size_type size() const { return (_bits.size()); }
+			size_type max_size() const { return (_bits.max_size()); }
+			size_type capacity() const { return (_bits.capacity()); }
+			bool empty() const { return (_bits.empty()); }
+
+			void resize(size_type n, value_type val = value_type())
+			{
+				_bits.resize(n, val);
+			}
+
+			void reserve(size_type n)
+			{
+				if (n > this->max_size())
+					throw std::length_error("vector::reserve");
+				_bits.reserve(n);
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type n) { return (_bits[n]); }
+			const_reference operator[](size_type n) const { return (_bits[n]); }
+
+			reference at(size_type n)
+			{
+				if (n >= this->size())
+					throw std::out_of_range("vector::at");
+				return (_bits[n]);
+			}
+			const_reference at(size_type n) const
+			{
+				if (n >= this->size())
+					throw std::out_of_range("vector::at");
+				return (_bits[n]);
+			}
+
+			reference front() { return (_bits[0]); }
+			const_reference front() const { return (_bits[0]); }
+			reference back() { return (_bits[this->size() - 1]); }
+			const_reference back() const { return (_bits[this->size() - 1]); }
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			void push_back(const value_type& val) { _bits.push_back(val); }
+			void pop_back() { _bits.pop_back(); }
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				size_type	pos = position.getIndex();
+
+				_bits.insert(pos, 1, val);
+				return (this->begin() + pos);
+			}
+
+			void insert(iterator position, size_type n, const value_type& val)
+			{
+				_bits.insert(position.getIndex(), n, val);
+			}
+
+			template <class InputIterator>
+			void insert(iterator position, typename ft::enable_if<!std::numeric_limits
+				<InputIterator>::is_integer, InputIterator>::type first,
+				InputIterator last)
+			{
+				bitset_type	tmp(0, false, _bits.get_allocator());
+				size_type	pos = position.getIndex();
+
+				for (; first != last; ++first)
+					tmp.push_back(*first);
+				_bits.insert(pos, tmp.size(), false);
+				for (size_type i = 0; i < tmp.size(); i++)
+					_bits[pos + i] = tmp[i];
+			}
+
+			iterator erase(iterator position)
+			{
+				size_type	pos = position.getIndex();
+
+				_bits.erase(pos, 1);
+				return (this->begin() + pos);
+			}
+
+			iterator erase(iterator first, iterator last)
+			{
+				size_type	pos = first.getIndex();
+
+				_bits.erase(pos, last - first);
+				return (this->begin() + pos);
+			}
+
+			void swap(vector& x)
+			{
+				allocator_type	tmp = _alloc;
+
+				_bits.swap(x._bits);
+				_alloc = x._alloc;
+				x._alloc = tmp;
+			}
+
+			/**
+			 * @brief Exchanges the bits referred to by x and y.
+			*/
+			static void swap(reference x, reference y)
+			{
+				bool	tmp = x;
+
+				x = y;
+				y = tmp;
+			}
+
+			/**
+			 * @brief Flips every element.
+			*/
+			void flip() { _bits.flip(); }
+
+			void clear() { _bits.clear(); }
+
+			allocator_type get_allocator() const { return (_alloc); }
+
+/*
+** ---------------------------------- BLOCKS -----------------------------------
+*/
+
+			/*
+			** Access to the packed words, used to serialize the vector
+			** without unpacking it.
+			*/
+
+			size_type num_blocks() const { return (_bits.num_blocks()); }
+
+			/**
+			 * @brief Returns the words holding the elements, element i being
+			 * bit i % 64 of word i / 64.
+			*/
+			const uint64_t* data() const { return (_bits.data()); }
+
+			/**
+			 * @brief Appends the 64 elements of each block of [first,last).
+			*/
+			template <class BlockInputIterator>
+			void append_blocks(BlockInputIterator first, BlockInputIterator last)
+			{
+				_bits.append(first, last);
+			}
+	};
+}
+
+#endif /* ************************************************ DYNAMIC_BITSET_HPP */
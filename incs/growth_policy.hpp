@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   growth_policy.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/19 10:14:09 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/19 10:14:09 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GROWTH_POLICY_HPP
+# define GROWTH_POLICY_HPP
+
+# include <stddef.h>
+
+/*
+** Page size assumed by growth_page, large buffers are rounded to it.
+*/
+# ifndef FT_PAGE_SIZE
+#  define FT_PAGE_SIZE 4096
+# endif
+
+namespace ft
+{
+	/*
+	** A growth policy tells a vector how much storage to allocate when it
+	** runs out of capacity. It provides a single static function:
+	**
+	**   size_t next_capacity(size_t capacity, size_t required, size_t elem)
+	**
+	** returning a capacity, in elements, of at least required, given the
+	** current capacity and the size in bytes of an element. Geometric growth
+	** is what makes repeated insertions amortised O(1).
+	*/
+
+	/**
+	 * @brief Doubles the capacity until the requirement is met. Fewest
+	 * reallocations, up to half of the buffer unused.
+	*/
+	struct growth_double
+	{
+		static size_t	next_capacity(size_t capacity, size_t required, size_t)
+		{
+			size_t	new_capacity = (capacity > 0 ? capacity : 1);
+
+			while (new_capacity < required)
+				new_capacity *= 2;
+			return (new_capacity);
+		}
+	};
+
+	/**
+	 * @brief Grows the capacity by half until the requirement is met. About
+	 * 1.7 times more reallocations than growth_double, but at most a third of
+	 * the buffer unused, and freed blocks can eventually be reused by the
+	 * allocator for a later growth.
+	*/
+	struct growth_half
+	{
+		static size_t	next_capacity(size_t capacity, size_t required, size_t)
+		{
+			size_t	new_capacity = (capacity > 1 ? capacity : 2);
+
+			while (new_capacity < required)
+				new_capacity += new_capacity / 2;
+			return (new_capacity);
+		}
+	};
+
+	/**
+	 * @brief Doubles the capacity, then rounds buffers larger than a page up
+	 * to a whole number of pages, so the slack the kernel maps anyway becomes
+	 * usable capacity.
+	*/
+	struct growth_page
+	{
+		static size_t	next_capacity(size_t capacity, size_t required,
+			size_t elem)
+		{
+			size_t	new_capacity = growth_double::next_capacity(capacity,
+				required, elem);
+			size_t	bytes = new_capacity * elem;
+
+			if (bytes <= FT_PAGE_SIZE)
+				return (new_capacity);
+			bytes = (bytes + FT_PAGE_SIZE - 1) & ~static_cast<size_t>(FT_PAGE_SIZE - 1);
+			return (bytes / elem);
+		}
+	};
+
+	/**
+	 * @brief Grows the capacity by half, then rounds the buffer up to the
+	 * size class malloc would serve it from anyway: four classes per power of
+	 * two (2^k, 1.25 * 2^k, 1.5 * 2^k, 1.75 * 2^k), as in jemalloc and
+	 * tcmalloc, and whole pages above that.
+	*/
+	struct growth_size_class
+	{
+		static size_t	next_capacity(size_t capacity, size_t required,
+			size_t elem)
+		{
+			size_t	new_capacity = growth_half::next_capacity(capacity,
+				required, elem);
+			size_t	bytes = new_capacity * elem;
+			size_t	step;
+
+			if (bytes <= 16)
+				return (16 / elem > new_capacity ? 16 / elem : new_capacity);
+			if (bytes > FT_PAGE_SIZE)
+				step = FT_PAGE_SIZE;
+			else
+			{
+				size_t	pow = 16;
+				while (pow * 2 < bytes)
+					pow *= 2;
+				step = pow / 4;
+			}
+			bytes = (bytes + step - 1) / step * step;
+			return (bytes / elem);
+		}
+	};
+}
+
+#endif /* ************************************************* GROWTH_POLICY_HPP */
@@ -0,0 +1,303 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   huge_page_allocator.hpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/20 14:02:47 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/20 14:02:47 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HUGE_PAGE_ALLOCATOR_HPP
+# define HUGE_PAGE_ALLOCATOR_HPP
+
+# include <new>
+# include <limits>
+# include <stdlib.h>
+# include <stddef.h>
+# include <string.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include "malloc_allocator.hpp"
+
+/*
+** Size of a transparent huge page. Large blocks are aligned and rounded to
+** it so the kernel can back them with huge pages from the first fault.
+*/
+# ifndef FT_HUGE_PAGE_SIZE
+#  define FT_HUGE_PAGE_SIZE (2UL << 20)
+# endif
+
+/*
+** Blocks of at least this many bytes are mapped directly, smaller ones come
+** from malloc.
+*/
+# ifndef FT_HUGE_PAGE_THRESHOLD
+#  define FT_HUGE_PAGE_THRESHOLD (4UL << 20)
+# endif
+
+namespace ft
+{
+	/**
+	 * @brief How the pages of a large block are placed on NUMA nodes.
+	 * numa_local keeps the kernel default (first touch), numa_interleave
+	 * spreads pages round-robin over all allowed nodes, numa_bind restricts
+	 * them to a single node.
+	*/
+	enum numa_policy
+	{
+		numa_local,
+		numa_interleave,
+		numa_bind
+	};
+
+	/**
+	 * @brief Allocator for large buffers. Blocks above a threshold are
+	 * mapped with mmap, aligned to FT_HUGE_PAGE_SIZE and advised for
+	 * transparent huge pages, which cuts TLB misses on big vectors; they can
+	 * also be interleaved or bound across NUMA nodes. Smaller blocks come from
+	 * malloc. Huge pages and NUMA placement are hints: where the kernel or
+	 * the platform does not support them, the block is used with normal
+	 * pages and default placement.
+	 * @tparam T Type of the elements.
+	*/
+	template <class T>
+	class huge_page_allocator
+	{
+		public:
+
+			typedef T			value_type;
+			typedef T*			pointer;
+			typedef const T*	const_pointer;
+			typedef T&			reference;
+			typedef const T&	const_reference;
+			typedef size_t		size_type;
+			typedef ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef huge_page_allocator<U>	other;
+			};
+
+			/**
+			 * @param policy NUMA placement of the large blocks.
+			 * @param node Node to bind to, used with numa_bind.
+			 * @param threshold Size in bytes from which blocks are mapped.
+			*/
+			explicit huge_page_allocator(numa_policy policy = numa_local,
+				int node = 0, size_t threshold = FT_HUGE_PAGE_THRESHOLD)
+			: _policy(policy), _node(node), _threshold(threshold) {}
+
+			huge_page_allocator(const huge_page_allocator& x)
+			: _policy(x._policy), _node(x._node), _threshold(x._threshold) {}
+
+			template <class U>
+			huge_page_allocator(const huge_page_allocator<U>& x)
+			: _policy(x.policy()), _node(x.node()), _threshold(x.threshold()) {}
+
+			~huge_page_allocator() {}
+
+			pointer address(reference x) const { return (&x); }
+			const_pointer address(const_reference x) const { return (&x); }
+
+			/**
+			 * @brief Allocates uninitialized storage for n elements.
+			 * @throw std::bad_alloc if the memory cannot be obtained.
+			*/
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n > this->max_size())
+					throw std::bad_alloc();
+				size_t	bytes = n * sizeof(T);
+				void*	p;
+
+				if (!is_mapped(bytes))
+				{
+					p = malloc(bytes);
+					if (p == NULL && bytes != 0)
+						throw std::bad_alloc();
+					return (static_cast<pointer>(p));
+				}
+				p = map(round(bytes));
+				advise(p, round(bytes));
+				return (static_cast<pointer>(p));
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+				size_t	bytes = n * sizeof(T);
+
+				if (is_mapped(bytes))
+					munmap(p, round(bytes));
+				else
+					free(p);
+			}
+
+			/**
+			 * @brief Resizes the block p, holding old_n elements, to hold
+			 * new_n. Mapped blocks are moved with mremap, which relinks their
+			 * pages instead of copying them. The common prefix is preserved
+			 * byte-wise, so this is only valid for trivially relocatable
+			 * elements.
+			 * @return The address of the resized block.
+			 * @throw std::bad_alloc if the memory cannot be obtained, p is
+			 * then left untouched.
+			*/
+			pointer reallocate(pointer p, size_type old_n, size_type new_n)
+			{
+				if (new_n > this->max_size())
+					throw std::bad_alloc();
+				size_t	old_bytes = old_n * sizeof(T);
+				size_t	new_bytes = new_n * sizeof(T);
+				void*	q;
+
+				if (!is_mapped(old_bytes) && !is_mapped(new_bytes))
+				{
+					q = realloc(p, new_bytes);
+					if (q == NULL && new_bytes != 0)
+						throw std::bad_alloc();
+					return (static_cast<pointer>(q));
+				}
+# ifdef MREMAP_MAYMOVE
+				if (is_mapped(old_bytes) && is_mapped(new_bytes))
+				{
+					q = mremap(p, round(old_bytes), round(new_bytes),
+						MREMAP_MAYMOVE);
+					if (q == MAP_FAILED)
+						throw std::bad_alloc();
+					advise(q, round(new_bytes));
+					return (static_cast<pointer>(q));
+				}
+# endif
+				q = this->allocate(new_n);
+				if (p == NULL)
+					return (static_cast<pointer>(q));
+				if (old_bytes && new_bytes)
+					memcpy(q, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+				this->deallocate(p, old_n);
+				return (static_cast<pointer>(q));
+			}
+
+			size_type max_size() const
+			{
+				return ((std::numeric_limits<size_type>::max()
+					- FT_HUGE_PAGE_SIZE) / sizeof(T));
+			}
+
+			void construct(pointer p, const_reference val)
+			{
+				new (static_cast<void*>(p)) T(val);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+
+			numa_policy policy() const { return (_policy); }
+			int node() const { return (_node); }
+			size_t threshold() const { return (_threshold); }
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			numa_policy		_policy;
+			int				_node;
+			size_t			_threshold;
+
+			bool is_mapped(size_t bytes) const
+			{
+				return (bytes >= _threshold && bytes != 0);
+			}
+
+			static size_t round(size_t bytes)
+			{
+				return ((bytes + FT_HUGE_PAGE_SIZE - 1)
+					& ~static_cast<size_t>(FT_HUGE_PAGE_SIZE - 1));
+			}
+
+			/**
+			 * @brief Maps len bytes aligned to FT_HUGE_PAGE_SIZE, by mapping
+			 * one extra huge page and trimming both ends.
+			*/
+			static void* map(size_t len)
+			{
+				size_t	span = len + FT_HUGE_PAGE_SIZE;
+				void*	raw = mmap(NULL, span, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+				if (raw == MAP_FAILED)
+					throw std::bad_alloc();
+				char*	start = static_cast<char*>(raw);
+				char*	aligned = reinterpret_cast<char*>(round(
+					reinterpret_cast<size_t>(start)));
+				if (aligned != start)
+					munmap(start, aligned - start);
+				if (aligned + len != start + span)
+					munmap(aligned + len, (start + span) - (aligned + len));
+				return (aligned);
+			}
+
+			/**
+			 * @brief Applies the huge page and NUMA hints to a mapped block.
+			 * Failures are ignored, the block stays usable either way.
+			*/
+			void advise(void* p, size_t len) const
+			{
+# ifdef MADV_HUGEPAGE
+				madvise(p, len, MADV_HUGEPAGE);
+# endif
+# ifdef SYS_mbind
+				/* Values of MPOL_BIND and MPOL_INTERLEAVE from <linux/mempolicy.h> */
+				unsigned long	mask;
+				int				mode;
+
+				if (_policy == numa_local)
+					return ;
+				if (_policy == numa_interleave)
+				{
+					mode = 3;
+					mask = ~0UL;
+				}
+				else
+				{
+					if (_node < 0 || _node >= static_cast<int>(sizeof(mask) * 8))
+						return ;
+					mode = 2;
+					mask = 1UL << _node;
+				}
+				syscall(SYS_mbind, p, len, mode, &mask, sizeof(mask) * 8, 0);
+# else
+				(void)p;
+				(void)len;
+# endif
+			}
+	};
+
+	template <class T, class U>
+	bool operator==(const huge_page_allocator<T>& lhs,
+		const huge_page_allocator<U>& rhs)
+	{
+		return (lhs.policy() == rhs.policy() && lhs.node() == rhs.node()
+			&& lhs.threshold() == rhs.threshold());
+	}
+
+	template <class T, class U>
+	bool operator!=(const huge_page_allocator<T>& lhs,
+		const huge_page_allocator<U>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T>
+	struct allocator_can_reallocate<huge_page_allocator<T> >
+	: public true_type {};
+}
+
+#endif /* ******************************************* HUGE_PAGE_ALLOCATOR_HPP */
@@ -0,0 +1,428 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   indexed_heap.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/24 15:21:10 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/24 15:21:10 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INDEXED_HEAP_HPP
+# define INDEXED_HEAP_HPP
+
+# include <functional>
+# include <new>
+# include <stdexcept>
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Addressable 4-ary min-heap. push returns a handle that stays
+	 * valid while its element is queued, through which the element can be
+	 * read, re-prioritised or removed in O(log n). The heap itself only
+	 * moves handles: elements stay in a slot table indexed by handle, and
+	 * each slot records where its handle currently sits in the heap.
+	 * Unlike priority_queue, the top is the smallest element according to
+	 * Compare, so decrease_key moves an element towards the top, as in
+	 * Dijkstra's algorithm. Slots of removed elements are reused, but as in
+	 * slot_map a handle carries the generation of its slot, so the handles
+	 * of removed elements are recognised as stale rather than aliasing the
+	 * element that took their slot.
+	 * @tparam T Type of the elements.
+	 * @tparam Compare Binary predicate ordering the elements.
+	*/
+	template <class T, class Compare = std::less<T> >
+	class indexed_heap
+	{
+		public:
+
+			typedef T			value_type;
+			typedef Compare		value_compare;
+			typedef size_t		size_type;
+
+			static const size_type	arity = 4;
+
+			/**
+			 * @brief Generational handle of an element.
+			*/
+			struct handle_type
+			{
+				size_type	index;
+				size_type	generation;
+
+				bool operator==(const handle_type& h) const
+				{
+					return (index == h.index && generation == h.generation);
+				}
+				bool operator!=(const handle_type& h) const
+				{
+					return (!(*this == h));
+				}
+			};
+
+		private:
+
+			static const size_type	npos = static_cast<size_type>(-1);
+
+			/**
+			 * @brief While pos is not npos, the slot holds an element, at
+			 * pos in the heap; otherwise its storage is uninitialised. The
+			 * generation is bumped each time the element is removed.
+			*/
+			struct Slot
+			{
+				size_type	pos;
+				size_type	generation;
+				char		storage[sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+				Slot(const T& v, size_type p) : pos(npos), generation(0)
+				{
+					::new (static_cast<void*>(storage)) T(v);
+					pos = p;
+				}
+
+				Slot(const Slot& x) : pos(npos), generation(x.generation)
+				{
+					if (x.pos != npos)
+						::new (static_cast<void*>(storage)) T(*x.val());
+					pos = x.pos;
+				}
+
+				~Slot()
+				{
+					if (pos != npos)
+						this->val()->~T();
+				}
+
+				Slot& operator=(const Slot& x)
+				{
+					if (this == &x)
+						return (*this);
+					if (pos != npos && x.pos != npos)
+						*this->val() = *x.val();
+					else if (pos != npos)
+						this->val()->~T();
+					else if (x.pos != npos)
+						::new (static_cast<void*>(storage)) T(*x.val());
+					pos = x.pos;
+					generation = x.generation;
+					return (*this);
+				}
+
+				T* val() { return (reinterpret_cast<T*>(storage)); }
+				const T* val() const { return (reinterpret_cast<const T*>(storage)); }
+			};
+
+			ft::vector<size_type>	_heap;
+			ft::vector<Slot>		_slots;
+			ft::vector<size_type>	_free;
+			value_compare			_comp;
+
+		public:
+
+			explicit indexed_heap(const value_compare& comp = value_compare())
+			: _comp(comp) {}
+
+			indexed_heap(const indexed_heap& x)
+			: _heap(x._heap), _slots(x._slots), _free(x._free), _comp(x._comp) {}
+
+			~indexed_heap() {}
+
+			indexed_heap& operator=(const indexed_heap& x)
+			{
+				indexed_heap	tmp(x);
+
+				this->swap(tmp);
+				return (*this);
+			}
+
+			bool empty() const { return (_heap.empty()); }
+			size_type size() const { return (_heap.size()); }
+
+			/**
+			 * @brief Returns the smallest element.
+			*/
+			const value_type& top() const
+			{
+				return (*_slots[_heap[0]].val());
+			}
+
+			/**
+			 * @brief Returns the handle of the smallest element.
+			*/
+			handle_type top_handle() const
+			{
+				return (this->handle_of(_heap[0]));
+			}
+
+			/**
+			 * @brief Returns the element of h, which must be valid.
+			*/
+			const value_type& operator[](const handle_type& h) const
+			{
+				return (*_slots[h.index].val());
+			}
+
+			/**
+			 * @brief Returns the element of h.
+			 * @throw std::out_of_range if h is stale.
+			*/
+			const value_type& at(const handle_type& h) const
+			{
+				if (!this->contains(h))
+					throw std::out_of_range("indexed_heap::at");
+				return ((*this)[h]);
+			}
+
+			/**
+			 * @brief Tells whether h refers to a queued element.
+			*/
+			bool contains(const handle_type& h) const
+			{
+				return (h.index < _slots.size()
+					&& _slots[h.index].generation == h.generation
+					&& _slots[h.index].pos != npos);
+			}
+
+			/**
+			 * @brief Inserts a copy of val, in O(log n).
+			 * @return The handle of the new element.
+			*/
+			handle_type push(const value_type& val)
+			{
+				size_type	i;
+
+				reserve_one(_heap);
+				if (_free.empty())
+				{
+					i = _slots.size();
+					_slots.push_back(Slot(val, _heap.size()));
+				}
+				else
+				{
+					i = _free.back();
+					::new (static_cast<void*>(_slots[i].storage)) T(val);
+					_free.pop_back();
+					_slots[i].pos = _heap.size();
+				}
+				_heap.push_back(i);
+				this->sift_up(_heap.size() - 1);
+				return (this->handle_of(i));
+			}
+
+			/**
+			 * @brief Removes the smallest element, in O(log n).
+			*/
+			void pop()
+			{
+				this->remove(_heap[0]);
+			}
+
+			/**
+			 * @brief Removes the element of h, if h is valid, in O(log n).
+			 * The element is destroyed and h becomes stale.
+			 * @return The number of elements removed.
+			*/
+			size_type erase(const handle_type& h)
+			{
+				if (!this->contains(h))
+					return (0);
+				this->remove(h.index);
+				return (1);
+			}
+
+			/**
+			 * @brief Replaces the element of h by val, which must not compare
+			 * greater than it, and moves it up, in O(log n).
+			 * @throw std::out_of_range if h is stale.
+			*/
+			void decrease_key(const handle_type& h, const value_type& val)
+			{
+				*this->checked(h, "indexed_heap::decrease_key").val() = val;
+				this->sift_up(_slots[h.index].pos);
+			}
+
+			/**
+			 * @brief Replaces the element of h by val, which must not compare
+			 * less than it, and moves it down, in O(log n).
+			 * @throw std::out_of_range if h is stale.
+			*/
+			void increase_key(const handle_type& h, const value_type& val)
+			{
+				*this->checked(h, "indexed_heap::increase_key").val() = val;
+				this->sift_down(_slots[h.index].pos);
+			}
+
+			/**
+			 * @brief Replaces the element of h by val, in either direction,
+			 * in O(log n).
+			 * @throw std::out_of_range if h is stale.
+			*/
+			void update(const handle_type& h, const value_type& val)
+			{
+				*this->checked(h, "indexed_heap::update").val() = val;
+				this->sift_down(this->sift_up(_slots[h.index].pos));
+			}
+
+			/**
+			 * @brief Removes every element and invalidates every handle. The
+			 * slots are kept, with their generations, for later pushes.
+			*/
+			void clear()
+			{
+				while (!_heap.empty())
+					this->remove(_heap.back());
+			}
+
+			void swap(indexed_heap& x)
+			{
+				value_compare	tmp = _comp;
+
+				_heap.swap(x._heap);
+				_slots.swap(x._slots);
+				_free.swap(x._free);
+				_comp = x._comp;
+				x._comp = tmp;
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			/**
+			 * @brief Makes room for one more index in v, so that the
+			 * following push_back cannot throw. A full vector grows through
+			 * its growth policy, keeping pushes amortized O(1).
+			*/
+			static void reserve_one(ft::vector<size_type>& v)
+			{
+				if (v.size() == v.capacity())
+					v.reserve(ft::vector<size_type>::growth_policy::next_capacity(
+						v.capacity(), v.size() + 1, sizeof(size_type)));
+			}
+
+			handle_type handle_of(size_type i) const
+			{
+				handle_type	h;
+
+				h.index = i;
+				h.generation = _slots[i].generation;
+				return (h);
+			}
+
+			/**
+			 * @brief Returns the slot of h.
+			 * @throw std::out_of_range, with what, if h is stale.
+			*/
+			Slot& checked(const handle_type& h, const char* what)
+			{
+				if (!this->contains(h))
+					throw std::out_of_range(what);
+				return (_slots[h.index]);
+			}
+
+			/**
+			 * @brief Removes the element of slot i: destroys it, bumps the
+			 * generation of the slot and gives it to the free list, then
+			 * fills its place in the heap with the last handle.
+			*/
+			void remove(size_type i)
+			{
+				size_type	pos = _slots[i].pos;
+				size_type	last = _heap.back();
+
+				reserve_one(_free);
+				_slots[i].val()->~T();
+				_slots[i].pos = npos;
+				_slots[i].generation++;
+				_free.push_back(i);
+				_heap.pop_back();
+				if (last == i)
+					return ;
+				this->place(pos, last);
+				this->sift_down(this->sift_up(pos));
+			}
+
+			bool less(size_type a, size_type b) const
+			{
+				return (_comp(*_slots[a].val(), *_slots[b].val()));
+			}
+
+			void place(size_type pos, size_type i)
+			{
+				_heap[pos] = i;
+				_slots[i].pos = pos;
+			}
+
+			/**
+			 * @brief Moves the handle at pos up while its element is smaller
+			 * than its parent's.
+			 * @return The final position of the handle.
+			*/
+			size_type sift_up(size_type pos)
+			{
+				size_type	h = _heap[pos];
+
+				while (pos > 0)
+				{
+					size_type	parent = (pos - 1) / arity;
+					if (!this->less(h, _heap[parent]))
+						break ;
+					this->place(pos, _heap[parent]);
+					pos = parent;
+				}
+				this->place(pos, h);
+				return (pos);
+			}
+
+			/**
+			 * @brief Moves the handle at pos down while one of its children's
+			 * elements is smaller, swapping it with the smallest child.
+			 * @return The final position of the handle.
+			*/
+			size_type sift_down(size_type pos)
+			{
+				size_type	n = _heap.size();
+				size_type	h = _heap[pos];
+
+				while (true)
+				{
+					size_type	first = pos * arity + 1;
+					if (first >= n)
+						break ;
+					size_type	last = (n - first > arity ? first + arity : n);
+					size_type	best = first;
+					for (size_type j = first + 1; j < last; j++)
+						if (this->less(_heap[j], _heap[best]))
+							best = j;
+					if (!this->less(_heap[best], h))
+						break ;
+					this->place(pos, _heap[best]);
+					pos = best;
+				}
+				this->place(pos, h);
+				return (pos);
+			}
+	};
+
+	template <class T, class Compare>
+	const typename indexed_heap<T,Compare>::size_type
+		indexed_heap<T,Compare>::arity;
+
+	template <class T, class Compare>
+	const typename indexed_heap<T,Compare>::size_type
+		indexed_heap<T,Compare>::npos;
+
+	template <class T, class Compare>
+	void swap(indexed_heap<T,Compare>& x, indexed_heap<T,Compare>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************** INDEXED_HEAP_HPP */
@@ -0,0 +1,430 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intrusive_list.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/25 16:12:40 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/25 16:12:40 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INTRUSIVE_LIST_HPP
+# define INTRUSIVE_LIST_HPP
+
+# include <stddef.h>
+# include <stdint.h>
+# include <iterator>
+
+namespace ft
+{
+	/**
+	 * @brief Links embedded in an object to put it in an intrusive_list. An
+	 * object can be in as many lists at a time as it has hooks. Copying an
+	 * object does not copy the links of its hooks: the copy is unlinked.
+	*/
+	struct list_hook
+	{
+		list_hook	*next;
+		list_hook	*prev;
+
+		list_hook() : next(NULL), prev(NULL) {}
+		list_hook(const list_hook&) : next(NULL), prev(NULL) {}
+		list_hook& operator=(const list_hook&) { return (*this); }
+
+		/**
+		 * @brief Tells whether the object is in a list through this hook.
+		*/
+		bool is_linked() const { return (next != NULL); }
+	};
+
+	/**
+	 * @brief Converts between an object and its hook, using the offset of
+	 * the hook within T.
+	*/
+	template <class T, list_hook T::* Hook>
+	struct Intrusive_list_traits
+	{
+		static ptrdiff_t offset()
+		{
+			T	*p = reinterpret_cast<T*>(static_cast<uintptr_t>(4096));
+
+			return (reinterpret_cast<char*>(&(p->*Hook))
+				- reinterpret_cast<char*>(p));
+		}
+		static T* owner(list_hook* h)
+		{
+			return (reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset()));
+		}
+		static list_hook* hook(T& x)
+		{
+			return (&(x.*Hook));
+		}
+	};
+
+	template<class T, list_hook T::* Hook> class Intrusive_list_const_iterator;
+
+	template<class T, list_hook T::* Hook>
+	class Intrusive_list_iterator
+	{
+		public:
+
+			typedef T								value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::bidirectional_iterator_tag	iterator_category;
+			typedef value_type*						pointer;
+			typedef value_type&						reference;
+			typedef list_hook*						NodePtr;
+
+		protected:
+
+			typedef Intrusive_list_traits<T, Hook>	traits;
+
+			NodePtr	m_node;
+
+		private:
+
+			Intrusive_list_iterator(const Intrusive_list_const_iterator<T, Hook>& ) {}
+
+		public:
+
+			Intrusive_list_iterator(NodePtr node = NULL) : m_node(node) {}
+			Intrusive_list_iterator(const Intrusive_list_iterator& from)
+			: m_node(from.m_node) {}
+			~Intrusive_list_iterator() {}
+
+			NodePtr	getNode() const { return m_node; }
+			Intrusive_list_iterator& operator=(const Intrusive_list_iterator& it)
+			{
+				if (this != &it)
+					m_node = it.m_node;
+				return (*this);
+			}
+
+			bool operator==(const Intrusive_list_iterator& it) const
+			{
+				return (m_node == it.m_node);
+			}
+			bool operator!=(const Intrusive_list_iterator& it) const
+			{
+				return (m_node != it.m_node);
+			}
+			reference operator*() const { return (*traits::owner(m_node)); }
+			pointer operator->() const { return (traits::owner(m_node)); }
+			Intrusive_list_iterator& operator++()
+			{
+				m_node = m_node->next;
+				return (*this);
+			}
+			Intrusive_list_iterator operator++(int)
+			{
+				Intrusive_list_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Intrusive_list_iterator& operator--()
+			{
+				m_node = m_node->prev;
+				return (*this);
+			}
+			Intrusive_list_iterator operator--(int)
+			{
+				Intrusive_list_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+	};
+
+	template<class T, list_hook T::* Hook>
+	class Intrusive_list_const_iterator : public Intrusive_list_iterator<T, Hook>
+	{
+		public:
+
+			typedef T const &	const_reference;
+			typedef T const *	const_pointer;
+			typedef list_hook*	NodePtr;
+
+			Intrusive_list_const_iterator(NodePtr node)
+			{
+				this->m_node = node;
+			}
+			Intrusive_list_const_iterator(const Intrusive_list_iterator<T, Hook>& from)
+			{
+				this->m_node = from.getNode();
+			}
+
+			Intrusive_list_const_iterator& operator=(const Intrusive_list_const_iterator& it)
+			{
+				if (this != &it)
+					this->m_node = it.m_node;
+				return (*this);
+			}
+			const_reference operator*() const
+			{
+				return (*Intrusive_list_traits<T, Hook>::owner(this->m_node));
+			}
+			const_pointer operator->() const
+			{
+				return (Intrusive_list_traits<T, Hook>::owner(this->m_node));
+			}
+	};
+
+	/**
+	 * @brief Doubly-linked list of objects that embed their own links, a
+	 * list_hook member given as template argument. The list neither
+	 * allocates nor copies: it links the objects it is given, which must
+	 * outlive their membership, so pushing and erasing never allocate, and
+	 * an object can be unlinked in O(1) from a reference to it. The list
+	 * does not own its objects and only unlinks them when destroyed.
+	 * @tparam T Type of the objects.
+	 * @tparam Hook Pointer to the list_hook member of T used by this list.
+	*/
+	template <class T, list_hook T::* Hook>
+	class intrusive_list
+	{
+		typedef Intrusive_list_traits<T, Hook>	traits;
+
+		public:
+
+			typedef T										value_type;
+			typedef T&										reference;
+			typedef const T&								const_reference;
+			typedef T*										pointer;
+			typedef const T*								const_pointer;
+			typedef Intrusive_list_iterator<T, Hook>		iterator;
+			typedef Intrusive_list_const_iterator<T, Hook>	const_iterator;
+			typedef ptrdiff_t								difference_type;
+			typedef size_t									size_type;
+
+		private:
+
+			list_hook	_sentinel;
+			size_type	_size;
+
+			intrusive_list(const intrusive_list&);
+			intrusive_list& operator=(const intrusive_list&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty list.
+			*/
+			intrusive_list() : _size(0)
+			{
+				_sentinel.next = &_sentinel;
+				_sentinel.prev = &_sentinel;
+			}
+
+			/**
+			 * @brief Unlinks every object. The objects themselves are left
+			 * untouched.
+			*/
+			~intrusive_list()
+			{
+				this->clear();
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(_sentinel.next)); }
+			const_iterator begin() const
+			{
+				return (const_iterator(_sentinel.next));
+			}
+			iterator end() { return (iterator(&_sentinel)); }
+			const_iterator end() const
+			{
+				return (const_iterator(const_cast<list_hook*>(&_sentinel)));
+			}
+
+			/**
+			 * @brief Returns an iterator to x, which must be in this list,
+			 * in O(1).
+			*/
+			iterator iterator_to(reference x)
+			{
+				return (iterator(traits::hook(x)));
+			}
+			const_iterator iterator_to(const_reference x) const
+			{
+				return (const_iterator(traits::hook(const_cast<reference>(x))));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_size == 0); }
+			size_type size() const { return (_size); }
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference front() { return (*traits::owner(_sentinel.next)); }
+			const_reference front() const
+			{
+				return (*traits::owner(_sentinel.next));
+			}
+			reference back() { return (*traits::owner(_sentinel.prev)); }
+			const_reference back() const
+			{
+				return (*traits::owner(_sentinel.prev));
+			}
+
+/*
+** --------------------------------- MODIFIERS ---------------------------------
+*/
+
+			/**
+			 * @brief Links x at the beginning of the list. x must not be in
+			 * a list through the same hook.
+			*/
+			void push_front(reference x)
+			{
+				this->insert(this->begin(), x);
+			}
+
+			/**
+			 * @brief Links x at the end of the list. x must not be in a list
+			 * through the same hook.
+			*/
+			void push_back(reference x)
+			{
+				this->insert(this->end(), x);
+			}
+
+			void pop_front()
+			{
+				this->erase(this->begin());
+			}
+
+			void pop_back()
+			{
+				this->erase(iterator(_sentinel.prev));
+			}
+
+			/**
+			 * @brief Links x before position, in O(1).
+			 * @return An iterator to x.
+			*/
+			iterator insert(iterator position, reference x)
+			{
+				list_hook	*node = traits::hook(x);
+				list_hook	*pos = position.getNode();
+
+				node->prev = pos->prev;
+				node->next = pos;
+				pos->prev->next = node;
+				pos->prev = node;
+				_size++;
+				return (iterator(node));
+			}
+
+			/**
+			 * @brief Unlinks the object at position, in O(1).
+			 * @return An iterator to the object that followed it.
+			*/
+			iterator erase(iterator position)
+			{
+				list_hook	*node = position.getNode();
+				list_hook	*next = node->next;
+
+				node->prev->next = next;
+				next->prev = node->prev;
+				node->next = NULL;
+				node->prev = NULL;
+				_size--;
+				return (iterator(next));
+			}
+
+			iterator erase(iterator first, iterator last)
+			{
+				while (first != last)
+					first = this->erase(first);
+				return (last);
+			}
+
+			/**
+			 * @brief Unlinks x, which must be in this list, in O(1).
+			*/
+			void erase(reference x)
+			{
+				this->erase(this->iterator_to(x));
+			}
+
+			/**
+			 * @brief Unlinks every object.
+			*/
+			void clear()
+			{
+				list_hook	*node = _sentinel.next;
+
+				while (node != &_sentinel)
+				{
+					list_hook	*next = node->next;
+					node->next = NULL;
+					node->prev = NULL;
+					node = next;
+				}
+				_sentinel.next = &_sentinel;
+				_sentinel.prev = &_sentinel;
+				_size = 0;
+			}
+
+			/**
+			 * @brief Moves every object of x before position, in O(1).
+			*/
+			void splice(iterator position, intrusive_list& x)
+			{
+				if (this == &x || x.empty())
+					return ;
+				list_hook	*pos = position.getNode();
+				list_hook	*first = x._sentinel.next;
+				list_hook	*last = x._sentinel.prev;
+
+				first->prev = pos->prev;
+				last->next = pos;
+				pos->prev->next = first;
+				pos->prev = last;
+				_size += x._size;
+				x._sentinel.next = &x._sentinel;
+				x._sentinel.prev = &x._sentinel;
+				x._size = 0;
+			}
+
+			/**
+			 * @brief Moves the object at i from x before position, in O(1).
+			*/
+			void splice(iterator position, intrusive_list& x, iterator i)
+			{
+				if (i == position || i.getNode()->next == position.getNode())
+					return ;
+				x.erase(i);
+				this->insert(position, *i);
+			}
+
+			/**
+			 * @brief Exchanges the objects of both lists, in O(1).
+			*/
+			void swap(intrusive_list& x)
+			{
+				intrusive_list	tmp;
+
+				tmp.splice(tmp.end(), x);
+				x.splice(x.end(), *this);
+				this->splice(this->end(), tmp);
+			}
+	};
+
+	template <class T, list_hook T::* Hook>
+	void swap(intrusive_list<T,Hook>& x, intrusive_list<T,Hook>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************ INTRUSIVE_LIST_HPP */
@@ -0,0 +1,680 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intrusive_map.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/26 09:37:15 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/26 09:37:15 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INTRUSIVE_MAP_HPP
+# define INTRUSIVE_MAP_HPP
+
+# include <stddef.h>
+# include <stdint.h>
+# include <algorithm>
+# include <functional>
+# include <iterator>
+# include "utils.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Links embedded in an object to put it in an intrusive_map: the
+	 * parent, children and height of its AVL node. An object can be in as
+	 * many trees at a time as it has hooks. Copying an object does not copy
+	 * the links of its hooks: the copy is unlinked.
+	*/
+	struct avl_hook
+	{
+		avl_hook	*parent;
+		avl_hook	*left;
+		avl_hook	*right;
+		int			height;
+
+		avl_hook() : parent(NULL), left(NULL), right(NULL), height(0) {}
+		avl_hook(const avl_hook&)
+		: parent(NULL), left(NULL), right(NULL), height(0) {}
+		avl_hook& operator=(const avl_hook&) { return (*this); }
+
+		/**
+		 * @brief Tells whether the object is in a tree through this hook.
+		*/
+		bool is_linked() const { return (parent != NULL); }
+	};
+
+	/**
+	 * @brief Converts between an object and its hook, using the offset of
+	 * the hook within T, and walks the tree in order. The header of a tree
+	 * is the only hook of height 0 reached by a walk.
+	*/
+	template <class T, avl_hook T::* Hook>
+	struct Intrusive_map_traits
+	{
+		static ptrdiff_t offset()
+		{
+			T	*p = reinterpret_cast<T*>(static_cast<uintptr_t>(4096));
+
+			return (reinterpret_cast<char*>(&(p->*Hook))
+				- reinterpret_cast<char*>(p));
+		}
+		static T* owner(avl_hook* h)
+		{
+			return (reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset()));
+		}
+		static avl_hook* hook(T& x)
+		{
+			return (&(x.*Hook));
+		}
+		static avl_hook* smallest(avl_hook* node)
+		{
+			while (node->left)
+				node = node->left;
+			return (node);
+		}
+		static avl_hook* biggest(avl_hook* node)
+		{
+			while (node->right)
+				node = node->right;
+			return (node);
+		}
+		static avl_hook* next(avl_hook* node)
+		{
+			if (node->right)
+				return (smallest(node->right));
+			while (node->parent->right == node)
+				node = node->parent;
+			return (node->parent);
+		}
+		static avl_hook* prev(avl_hook* node)
+		{
+			if (node->height == 0)
+				return (biggest(node->left));
+			if (node->left)
+				return (biggest(node->left));
+			while (node->parent->left == node)
+				node = node->parent;
+			return (node->parent);
+		}
+	};
+
+	template<class T, avl_hook T::* Hook> class Intrusive_map_const_iterator;
+
+	template<class T, avl_hook T::* Hook>
+	class Intrusive_map_iterator
+	{
+		public:
+
+			typedef T								value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::bidirectional_iterator_tag	iterator_category;
+			typedef value_type*						pointer;
+			typedef value_type&						reference;
+			typedef avl_hook*						NodePtr;
+
+		protected:
+
+			typedef Intrusive_map_traits<T, Hook>	traits;
+
+			NodePtr	m_node;
+
+		private:
+
+			Intrusive_map_iterator(const Intrusive_map_const_iterator<T, Hook>& ) {}
+
+		public:
+
+			Intrusive_map_iterator(NodePtr node = NULL) : m_node(node) {}
+			Intrusive_map_iterator(const Intrusive_map_iterator& from)
+			: m_node(from.m_node) {}
+			~Intrusive_map_iterator() {}
+
+			NodePtr	getNode() const { return m_node; }
+			Intrusive_map_iterator& operator=(const Intrusive_map_iterator& it)
+			{
+				if (this != &it)
+					m_node = it.m_node;
+				return (*this);
+			}
+
+			bool operator==(const Intrusive_map_iterator& it) const
+			{
+				return (m_node == it.m_node);
+			}
+			bool operator!=(const Intrusive_map_iterator& it) const
+			{
+				return (m_node != it.m_node);
+			}
+			reference operator*() const { return (*traits::owner(m_node)); }
+			pointer operator->() const { return (traits::owner(m_node)); }
+			Intrusive_map_iterator& operator++()
+			{
+				m_node = traits::next(m_node);
+				return (*this);
+			}
+			Intrusive_map_iterator operator++(int)
+			{
+				Intrusive_map_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Intrusive_map_iterator& operator--()
+			{
+				m_node = traits::prev(m_node);
+				return (*this);
+			}
+			Intrusive_map_iterator operator--(int)
+			{
+				Intrusive_map_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+	};
+
+	template<class T, avl_hook T::* Hook>
+	class Intrusive_map_const_iterator : public Intrusive_map_iterator<T, Hook>
+	{
+		public:
+
+			typedef T const &	const_reference;
+			typedef T const *	const_pointer;
+			typedef avl_hook*	NodePtr;
+
+			Intrusive_map_const_iterator(NodePtr node)
+			{
+				this->m_node = node;
+			}
+			Intrusive_map_const_iterator(const Intrusive_map_iterator<T, Hook>& from)
+			{
+				this->m_node = from.getNode();
+			}
+
+			Intrusive_map_const_iterator& operator=(const Intrusive_map_const_iterator& it)
+			{
+				if (this != &it)
+					this->m_node = it.m_node;
+				return (*this);
+			}
+			const_reference operator*() const
+			{
+				return (*Intrusive_map_traits<T, Hook>::owner(this->m_node));
+			}
+			const_pointer operator->() const
+			{
+				return (Intrusive_map_traits<T, Hook>::owner(this->m_node));
+			}
+	};
+
+	/**
+	 * @brief Ordered set of objects with unique keys, which embed the nodes
+	 * of the AVL tree: an avl_hook member given as template argument. Like
+	 * ft::map, the tree is kept balanced by rotations, but it neither
+	 * allocates nor copies: inserting links the object itself, so an object
+	 * with several hooks can be indexed by several keys at once. Erasing an
+	 * object needs no search, only the O(log n) rebalancing up to the root.
+	 * The tree does not own its objects and only unlinks them when destroyed.
+	 * @tparam Key Type of the keys.
+	 * @tparam T Type of the objects.
+	 * @tparam Hook Pointer to the avl_hook member of T used by this tree.
+	 * @tparam KeyOfValue Function object returning the key of an object.
+	 * @tparam Compare Binary predicate ordering the keys.
+	*/
+	template <class Key, class T, avl_hook T::* Hook, class KeyOfValue,
+		class Compare = std::less<Key> >
+	class intrusive_map
+	{
+		typedef Intrusive_map_traits<T, Hook>	traits;
+
+		public:
+
+			typedef Key										key_type;
+			typedef T										value_type;
+			typedef KeyOfValue								key_of_value;
+			typedef Compare									key_compare;
+			typedef T&										reference;
+			typedef const T&								const_reference;
+			typedef T*										pointer;
+			typedef const T*								const_pointer;
+			typedef Intrusive_map_iterator<T, Hook>			iterator;
+			typedef Intrusive_map_const_iterator<T, Hook>	const_iterator;
+			typedef ptrdiff_t								difference_type;
+			typedef size_t									size_type;
+
+		private:
+
+			avl_hook		_header;
+			size_type		_size;
+			key_of_value	_key;
+			key_compare		_comp;
+
+			intrusive_map(const intrusive_map&);
+			intrusive_map& operator=(const intrusive_map&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty tree. Its root is the left child of
+			 * an internal header, which is also the past-the-end node.
+			*/
+			explicit intrusive_map(const key_compare& comp = key_compare(),
+				const key_of_value& key = key_of_value())
+			: _size(0), _key(key), _comp(comp) {}
+
+			/**
+			 * @brief Unlinks every object. The objects themselves are left
+			 * untouched.
+			*/
+			~intrusive_map()
+			{
+				this->clear();
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin()
+			{
+				return (iterator(_header.left ? traits::smallest(_header.left)
+					: &_header));
+			}
+			const_iterator begin() const
+			{
+				return (const_cast<intrusive_map*>(this)->begin());
+			}
+			iterator end() { return (iterator(&_header)); }
+			const_iterator end() const
+			{
+				return (const_iterator(const_cast<avl_hook*>(&_header)));
+			}
+
+			/**
+			 * @brief Returns an iterator to x, which must be in this tree,
+			 * in O(1).
+			*/
+			iterator iterator_to(reference x)
+			{
+				return (iterator(traits::hook(x)));
+			}
+			const_iterator iterator_to(const_reference x) const
+			{
+				return (const_iterator(traits::hook(const_cast<reference>(x))));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_size == 0); }
+			size_type size() const { return (_size); }
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Links x into the tree, unless an object with an
+			 * equivalent key is already there. Nothing is allocated.
+			 * x must not be in a tree through the same hook.
+			 * @return A pair of an iterator to x or to the object that
+			 * prevented its insertion, and whether x was inserted.
+			*/
+			ft::pair<iterator,bool> insert(reference x)
+			{
+				avl_hook	*parent = &_header;
+				avl_hook	**link = &_header.left;
+				avl_hook	*node = traits::hook(x);
+
+				while (*link)
+				{
+					parent = *link;
+					if (_comp(_key(x), _key(*traits::owner(parent))))
+						link = &parent->left;
+					else if (_comp(_key(*traits::owner(parent)), _key(x)))
+						link = &parent->right;
+					else
+						return (ft::make_pair(iterator(parent), false));
+				}
+				node->parent = parent;
+				node->left = NULL;
+				node->right = NULL;
+				node->height = 1;
+				*link = node;
+				_size++;
+				this->tree_rebalance(parent);
+				return (ft::make_pair(iterator(node), true));
+			}
+
+			/**
+			 * @brief Unlinks the object at position and rebalances the tree,
+			 * in O(log n) without any search.
+			 * @return An iterator to the object that followed it.
+			*/
+			iterator erase(iterator position)
+			{
+				iterator	next = position;
+
+				++next;
+				this->tree_unlink(position.getNode());
+				return (next);
+			}
+
+			/**
+			 * @brief Unlinks x, which must be in this tree.
+			*/
+			void erase(reference x)
+			{
+				this->tree_unlink(traits::hook(x));
+			}
+
+			/**
+			 * @brief Unlinks the object with key k, if any.
+			 * @return The number of objects unlinked.
+			*/
+			size_type erase(const key_type& k)
+			{
+				iterator	it = this->find(k);
+
+				if (it == this->end())
+					return (0);
+				this->tree_unlink(it.getNode());
+				return (1);
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					first = this->erase(first);
+			}
+
+			/**
+			 * @brief Unlinks every object, in O(n).
+			*/
+			void clear()
+			{
+				this->tree_clear(_header.left);
+				_header.left = NULL;
+				_size = 0;
+			}
+
+			/**
+			 * @brief Exchanges the objects of both trees, in O(1).
+			*/
+			void swap(intrusive_map& x)
+			{
+				std::swap(_header.left, x._header.left);
+				std::swap(_size, x._size);
+				std::swap(_key, x._key);
+				std::swap(_comp, x._comp);
+				if (_header.left)
+					_header.left->parent = &_header;
+				if (x._header.left)
+					x._header.left->parent = &x._header;
+			}
+
+/*
+** -------------------------------- OBSERVERS ----------------------------------
+*/
+
+			key_compare key_comp() const { return (_comp); }
+			key_of_value key_of() const { return (_key); }
+
+/*
+** -------------------------------- OPERATIONS ---------------------------------
+*/
+
+			iterator find(const key_type& k)
+			{
+				iterator	it = this->lower_bound(k);
+
+				if (it == this->end() || _comp(k, _key(*it)))
+					return (this->end());
+				return (it);
+			}
+			const_iterator find(const key_type& k) const
+			{
+				return (const_cast<intrusive_map*>(this)->find(k));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->find(k) != this->end());
+			}
+
+			/**
+			 * @brief Returns an iterator to the first object whose key is not
+			 * less than k.
+			*/
+			iterator lower_bound(const key_type& k)
+			{
+				avl_hook	*node = _header.left;
+				avl_hook	*best = &_header;
+
+				while (node)
+				{
+					if (_comp(_key(*traits::owner(node)), k))
+						node = node->right;
+					else
+					{
+						best = node;
+						node = node->left;
+					}
+				}
+				return (iterator(best));
+			}
+			const_iterator lower_bound(const key_type& k) const
+			{
+				return (const_cast<intrusive_map*>(this)->lower_bound(k));
+			}
+
+			/**
+			 * @brief Returns an iterator to the first object whose key is
+			 * greater than k.
+			*/
+			iterator upper_bound(const key_type& k)
+			{
+				avl_hook	*node = _header.left;
+				avl_hook	*best = &_header;
+
+				while (node)
+				{
+					if (_comp(k, _key(*traits::owner(node))))
+					{
+						best = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return (iterator(best));
+			}
+			const_iterator upper_bound(const key_type& k) const
+			{
+				return (const_cast<intrusive_map*>(this)->upper_bound(k));
+			}
+
+			ft::pair<iterator,iterator> equal_range(const key_type& k)
+			{
+				return (ft::make_pair(this->lower_bound(k), this->upper_bound(k)));
+			}
+			ft::pair<const_iterator,const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::make_pair(this->lower_bound(k), this->upper_bound(k)));
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			int		tree_height(avl_hook* node) const
+			{
+				if (node != NULL)
+					return (node->height);
+				return (0);
+			}
+
+			int		tree_getbalance(avl_hook* node) const
+			{
+				return (tree_height(node->left) - tree_height(node->right));
+			}
+
+			void	tree_update_height(avl_hook* node)
+			{
+				node->height = std::max(tree_height(node->left),
+					tree_height(node->right)) + 1;
+			}
+
+			/**
+			 * @brief Makes child take the place of node under its parent.
+			*/
+			void	tree_replace(avl_hook* node, avl_hook* child)
+			{
+				avl_hook	*parent = node->parent;
+
+				if (parent->left == node)
+					parent->left = child;
+				else
+					parent->right = child;
+				if (child)
+					child->parent = parent;
+			}
+
+			/**
+			 * @brief Performs a Right-Right rotation of the given node: its
+			 * right child takes its place.
+			 * @return The root of the new subtree.
+			*/
+			avl_hook*	tree_rr_rotate(avl_hook* node)
+			{
+				avl_hook	*new_parent = node->right;
+
+				this->tree_replace(node, new_parent);
+				node->right = new_parent->left;
+				if (new_parent->left)
+					new_parent->left->parent = node;
+				new_parent->left = node;
+				node->parent = new_parent;
+				this->tree_update_height(node);
+				this->tree_update_height(new_parent);
+				return (new_parent);
+			}
+
+			/**
+			 * @brief Performs a Left-Left rotation of the given node: its
+			 * left child takes its place.
+			 * @return The root of the new subtree.
+			*/
+			avl_hook*	tree_ll_rotate(avl_hook* node)
+			{
+				avl_hook	*new_parent = node->left;
+
+				this->tree_replace(node, new_parent);
+				node->left = new_parent->right;
+				if (new_parent->right)
+					new_parent->right->parent = node;
+				new_parent->right = node;
+				node->parent = new_parent;
+				this->tree_update_height(node);
+				this->tree_update_height(new_parent);
+				return (new_parent);
+			}
+
+			/**
+			 * @brief Restores heights and balance factors from node up to the
+			 * root, rotating where a subtree leans by more than one level.
+			*/
+			void	tree_rebalance(avl_hook* node)
+			{
+				while (node != &_header)
+				{
+					this->tree_update_height(node);
+					int	factor = tree_getbalance(node);
+					if (factor > 1)
+					{
+						if (tree_getbalance(node->left) < 0)
+							this->tree_rr_rotate(node->left);
+						node = this->tree_ll_rotate(node);
+					}
+					else if (factor < -1)
+					{
+						if (tree_getbalance(node->right) > 0)
+							this->tree_ll_rotate(node->right);
+						node = this->tree_rr_rotate(node);
+					}
+					node = node->parent;
+				}
+			}
+
+			/**
+			 * @brief Unlinks node. A node with two children is replaced by
+			 * its successor, relinked in its place since the objects cannot
+			 * be copied around as in ft::map.
+			*/
+			void	tree_unlink(avl_hook* node)
+			{
+				avl_hook	*start;
+
+				if (node->left == NULL || node->right == NULL)
+				{
+					start = node->parent;
+					this->tree_replace(node, node->left ? node->left : node->right);
+				}
+				else
+				{
+					avl_hook	*next = traits::smallest(node->right);
+
+					if (next->parent == node)
+						start = next;
+					else
+					{
+						start = next->parent;
+						this->tree_replace(next, next->right);
+						next->right = node->right;
+						next->right->parent = next;
+					}
+					this->tree_replace(node, next);
+					next->left = node->left;
+					next->left->parent = next;
+					next->height = node->height;
+				}
+				node->parent = NULL;
+				node->left = NULL;
+				node->right = NULL;
+				node->height = 0;
+				_size--;
+				this->tree_rebalance(start);
+			}
+
+			/**
+			 * @brief Resets the hooks of every node of the subtree.
+			*/
+			void	tree_clear(avl_hook* node)
+			{
+				while (node)
+				{
+					this->tree_clear(node->left);
+					avl_hook	*right = node->right;
+					node->parent = NULL;
+					node->left = NULL;
+					node->right = NULL;
+					node->height = 0;
+					node = right;
+				}
+			}
+	};
+
+	template <class Key, class T, avl_hook T::* Hook, class KeyOfValue,
+		class Compare>
+	void swap(intrusive_map<Key,T,Hook,KeyOfValue,Compare>& x,
+		intrusive_map<Key,T,Hook,KeyOfValue,Compare>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************* INTRUSIVE_MAP_HPP */
@@ -32,13 +32,19 @@ namespace ft
 	template <class T, class Alloc = std::allocator<T> >
 	class list
 	{
-		struct Node
+		struct Node;
+
+		struct Node_links
 		{
-			T			val;
 			Node*		next;
 			Node*		prev;
 		};
 
+		struct Node : public Node_links
+		{
+			T			val;
+		};
+
 		public:
 
 			typedef T											value_type;
@@ -60,23 +66,20 @@ namespace ft
 
 			size_type		_size;
 			allocator_type	_alloc;
+			Node_links		_sentinel;
 			Node*			_head;
 
 		public:
 
 			/**
 			 * @brief empty container constructor (default constructor):
-			 * Constructs an empty container, with no elements.
+			 * Constructs an empty container, with no elements. Nothing is
+			 * allocated until the first element is inserted.
 			 * @param alloc Allocator object.
 			 * The container keeps and uses an internal copy of this allocator.
 			*/
 			explicit list(const allocator_type& alloc = allocator_type())
-			: _size(0), _alloc(alloc), _head(NULL)
-			{
-				_head = Node_allocator(_alloc).allocate(1);
-				_head->next = _head;
-				_head->prev = _head;
-			}
+			: _size(0), _alloc(alloc), _head(sentinel()) {}
 
 			/**
 			 * @brief fill constructor: Constructs a container with n elements.
@@ -90,11 +93,8 @@ namespace ft
 			*/
 			explicit list(size_type n, const value_type& val = value_type(),
                 const allocator_type& alloc = allocator_type())
-			: _size(0), _alloc(alloc), _head(NULL)
+			: _size(0), _alloc(alloc), _head(sentinel())
 			{
-				_head = Node_allocator(_alloc).allocate(1);
-				_head->next = _head;
-				_head->prev = _head;
 				while (n--)
 					this->push_front(val);
 			}
@@ -115,11 +115,8 @@ namespace ft
 			list(typename ft::enable_if<!std::numeric_limits<InputIterator>
 				::is_integer, InputIterator>::type first, InputIterator last,
 				const allocator_type& alloc = allocator_type())
-			: _size(0), _alloc(alloc), _head(NULL)
+			: _size(0), _alloc(alloc), _head(sentinel())
 			{
-				_head = Node_allocator(_alloc).allocate(1);
-				_head->next = _head;
-				_head->prev = _head;
 				for (; first != last; first++)
 					this->push_back(*first);
 			}
@@ -132,11 +129,8 @@ namespace ft
 			 * acquired.
 			*/
 			list(const list& x)
-			: _size(0), _alloc(x._alloc), _head(NULL)
+			: _size(0), _alloc(x._alloc), _head(sentinel())
 			{
-				_head = Node_allocator(_alloc).allocate(1);
-				_head->next = _head;
-				_head->prev = _head;
 				*this = x;
 			}
 
@@ -149,7 +143,6 @@ namespace ft
 			{
 				while (!empty())
 					this->pop_front();
-				Node_allocator(_alloc).deallocate(_head, 1);
 			}
 
 			/**
@@ -403,8 +396,7 @@ namespace ft
 			*/
 			void push_front(const value_type& val)
 			{
-				Node *element = Node_allocator(_alloc).allocate(1);
-				_alloc.construct(&element->val, val);
+				Node *element = this->create_node(val);
 				element->next = _head->next;
 				element->next->prev = element;
 				element->prev = _head;
@@ -439,8 +431,7 @@ namespace ft
 			*/
 			void push_back(const value_type& val)
 			{
-				Node *element = Node_allocator(_alloc).allocate(1);
-				_alloc.construct(&element->val, val);
+				Node *element = this->create_node(val);
 				element->next = _head;
 				element->prev = _head->prev;
 				element->prev->next = element;
@@ -476,8 +467,7 @@ namespace ft
 			*/
 			iterator insert(iterator position, const value_type& val)
 			{
-				Node *element = Node_allocator(_alloc).allocate(1);
-				_alloc.construct(&element->val, val);
+				Node *element = this->create_node(val);
 				element->next = position.getNode()->prev->next;
 				element->prev = position.getNode()->prev;
 				element->prev->next = element;
@@ -579,9 +569,11 @@ namespace ft
 			*/
 			void swap(list& x)
 			{
-				swap(_head, x._head);
+				swap(_sentinel, x._sentinel);
 				swap(_size, x._size);
 				swap(_alloc, x._alloc);
+				this->relink_sentinel();
+				x.relink_sentinel();
 			}
 
 			/**
@@ -657,7 +649,19 @@ namespace ft
 			*/
 			void splice(iterator position, list& x, iterator i)
 			{
-				this->splice(position, x, i, ++i);
+				Node	*node = i.getNode();
+				Node	*pos = position.getNode();
+
+				if (node == pos || node->next == pos)
+					return ;
+				node->prev->next = node->next;
+				node->next->prev = node->prev;
+				node->prev = pos->prev;
+				node->next = pos;
+				pos->prev->next = node;
+				pos->prev = node;
+				x._size--;
+				this->_size++;
 			}
 
 			/**
@@ -900,6 +904,54 @@ namespace ft
 
 		private:
 
+			/**
+			 * @brief Allocates a node holding a copy of val, releasing it if
+			 * the copy throws.
+			*/
+			Node*	create_node(const value_type& val)
+			{
+				Node	*element = Node_allocator(_alloc).allocate(1);
+
+				try
+				{
+					_alloc.construct(&element->val, val);
+				}
+				catch (...)
+				{
+					Node_allocator(_alloc).deallocate(element, 1);
+					throw;
+				}
+				return (element);
+			}
+
+			/**
+			 * @brief Returns the end node, which is embedded in the list so
+			 * that an empty list owns no storage. Only its links are ever
+			 * accessed, it holds no value.
+			*/
+			Node*	sentinel()
+			{
+				_sentinel.next = static_cast<Node*>(&_sentinel);
+				_sentinel.prev = static_cast<Node*>(&_sentinel);
+				return (static_cast<Node*>(&_sentinel));
+			}
+
+			/**
+			 * @brief Points the first and last nodes back to this list's
+			 * sentinel after its links were exchanged with another list.
+			*/
+			void	relink_sentinel()
+			{
+				if (_size == 0)
+				{
+					_sentinel.next = _head;
+					_sentinel.prev = _head;
+					return ;
+				}
+				_sentinel.next->prev = _head;
+				_sentinel.prev->next = _head;
+			}
+
 			template<class U>
 			void swap(U& u1, U& u2)
 			{
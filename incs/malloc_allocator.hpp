@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   malloc_allocator.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/20 10:36:12 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/20 10:36:12 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MALLOC_ALLOCATOR_HPP
+# define MALLOC_ALLOCATOR_HPP
+
+# include <new>
+# include <limits>
+# include <stdlib.h>
+# include <stddef.h>
+# include "type_traits.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Allocator backed by malloc/free. On top of the standard
+	 * allocator interface it can resize a block with realloc, which extends
+	 * it in place when the heap allows it, and remaps the pages of large
+	 * (mmap-backed) blocks with mremap instead of copying them. Containers
+	 * use it for elements that are trivially relocatable.
+	 * @tparam T Type of the elements.
+	*/
+	template <class T>
+	class malloc_allocator
+	{
+		public:
+
+			typedef T			value_type;
+			typedef T*			pointer;
+			typedef const T*	const_pointer;
+			typedef T&			reference;
+			typedef const T&	const_reference;
+			typedef size_t		size_type;
+			typedef ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef malloc_allocator<U>	other;
+			};
+
+			malloc_allocator() {}
+			malloc_allocator(const malloc_allocator&) {}
+			template <class U>
+			malloc_allocator(const malloc_allocator<U>&) {}
+			~malloc_allocator() {}
+
+			pointer address(reference x) const { return (&x); }
+			const_pointer address(const_reference x) const { return (&x); }
+
+			/**
+			 * @brief Allocates uninitialized storage for n elements.
+			 * @throw std::bad_alloc if malloc fails.
+			*/
+			pointer allocate(size_type n, const void* = 0)
+			{
+				if (n > this->max_size())
+					throw std::bad_alloc();
+				void*	p = malloc(n * sizeof(T));
+				if (p == NULL && n != 0)
+					throw std::bad_alloc();
+				return (static_cast<pointer>(p));
+			}
+
+			void deallocate(pointer p, size_type)
+			{
+				free(p);
+			}
+
+			/**
+			 * @brief Resizes the block p, holding old_n elements, to hold
+			 * new_n. The common prefix is preserved byte-wise, so this is only
+			 * valid for trivially relocatable elements.
+			 * @return The address of the resized block, which may differ from
+			 * p. On failure p is left untouched.
+			 * @throw std::bad_alloc if realloc fails.
+			*/
+			pointer reallocate(pointer p, size_type, size_type new_n)
+			{
+				if (new_n > this->max_size())
+					throw std::bad_alloc();
+				void*	q = realloc(p, new_n * sizeof(T));
+				if (q == NULL && new_n != 0)
+					throw std::bad_alloc();
+				return (static_cast<pointer>(q));
+			}
+
+			size_type max_size() const
+			{
+				return (std::numeric_limits<size_type>::max() / sizeof(T));
+			}
+
+			void construct(pointer p, const_reference val)
+			{
+				new (static_cast<void*>(p)) T(val);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+	};
+
+	template <class T, class U>
+	bool operator==(const malloc_allocator<T>&, const malloc_allocator<U>&)
+	{
+		return (true);
+	}
+
+	template <class T, class U>
+	bool operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&)
+	{
+		return (false);
+	}
+
+	/**
+	 * @brief Tells whether Alloc provides reallocate(p, old_n, new_n), which
+	 * containers may use to grow buffers of trivially relocatable elements
+	 * without copying them.
+	*/
+	template <class Alloc>
+	struct allocator_can_reallocate : public false_type {};
+
+	template <class T>
+	struct allocator_can_reallocate<malloc_allocator<T> > : public true_type {};
+}
+
+#endif /* ********************************************** MALLOC_ALLOCATOR_HPP */
@@ -131,9 +131,7 @@ namespace ft
 			map(const map& x)
 			: _root(NULL), _lastinsert(NULL), _size(0), _comp(key_compare()), _alloc(allocator_type())
 			{
-				const_iterator ite = x.end();
-				for (const_iterator it = x.begin(); it != ite; it++)
-					this->insert(*it);
+				this->assign_sorted(x.begin(), x.size());
 			}
 
 			/**
@@ -397,6 +395,24 @@ namespace ft
 					this->insert(*first++);
 			}
 
+			/**
+			 * @brief Replaces the contents of the container with the n
+			 * elements read from first, in O(n) rather than O(n log n): the
+			 * tree is built perfectly balanced without any comparison. The
+			 * elements must be sorted by key and have unique keys.
+			 * @param first Input iterator to the first element, read exactly
+			 * n times.
+			 * @param n Number of elements.
+			*/
+			template <class InputIterator>
+			void assign_sorted(InputIterator first, size_type n)
+			{
+				this->clear();
+				_root = this->tree_build(first, n);
+				if (_root)
+					_root->parent = NULL;
+			}
+
 			/**
 			 * @brief Removes a single element from the map container.
 			 * This effectively reduces the container size by one and destroy
@@ -925,6 +941,41 @@ namespace ft
 				return (node);
 			}
 
+			/**
+			 * @brief Builds a balanced tree from the next n elements of first,
+			 * which are in order: the middle element becomes the root of the
+			 * two halves. Nodes already built are released if reading an
+			 * element throws.
+			 * @return The root of the new tree, its parent is left unset.
+			*/
+			template <class InputIterator>
+			Node*	tree_build(InputIterator& first, size_type n)
+			{
+				if (n == 0)
+					return (NULL);
+				Node*	left = this->tree_build(first, n / 2);
+				Node*	node = NULL;
+				try
+				{
+					node = this->tree_create_node(*first, NULL);
+					node->left = left;
+					if (left)
+						left->parent = node;
+					++first;
+					node->right = this->tree_build(first, n - n / 2 - 1);
+				}
+				catch (...)
+				{
+					this->tree_clear(node ? node : left);
+					throw;
+				}
+				if (node->right)
+					node->right->parent = node;
+				node->height = 1 + std::max(tree_height(node->left),
+					tree_height(node->right));
+				return (node);
+			}
+
 			/**
 			 * @brief Removes every node from the tree.
 			*/
@@ -0,0 +1,452 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mmap_vector.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/21 09:17:26 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/21 09:17:26 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MMAP_VECTOR_HPP
+# define MMAP_VECTOR_HPP
+
+# include <limits>
+# include <string>
+# include <stdexcept>
+# include <errno.h>
+# include <fcntl.h>
+# include <string.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include "growth_policy.hpp"
+# include "type_traits.hpp"
+# include "vector_iterators.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief How an mmap_vector maps its file.
+	 * mmap_read_only: the elements can only be read, modifiers throw.
+	 * mmap_read_write: changes are written back to the file, which grows with
+	 * the vector.
+	 * mmap_copy_on_write: changes stay private to the process, the file is
+	 * never modified.
+	*/
+	enum mmap_mode
+	{
+		mmap_read_only,
+		mmap_read_write,
+		mmap_copy_on_write
+	};
+
+	/**
+	 * @brief Vector whose elements live in a memory mapped file, stored as a
+	 * raw array of T. Opening a file is O(1): pages are loaded lazily on first
+	 * access, so large read-mostly arrays need no deserialisation at startup.
+	 * A default constructed mmap_vector is backed by anonymous memory.
+	 * In mmap_read_write mode the file is extended with ftruncate as capacity
+	 * grows, and trimmed back to size() elements by close().
+	 * @tparam T Type of the elements, must be trivially copyable.
+	 * @tparam Growth Growth policy deciding the new capacity when the vector
+	 * runs out of storage (see growth_policy.hpp). By default, the capacity
+	 * is doubled.
+	*/
+	template <class T, class Growth = growth_double>
+	class mmap_vector
+	{
+		public:
+
+			typedef T									value_type;
+			typedef Growth								growth_policy;
+			typedef T&									reference;
+			typedef const T&							const_reference;
+			typedef T*									pointer;
+			typedef const T*							const_pointer;
+			typedef Vector_iterator<T>					iterator;
+			typedef Vector_const_iterator<T>			const_iterator;
+			typedef Vector_const_reverse_iterator<T>	const_reverse_iterator;
+			typedef Vector_reverse_iterator<T>			reverse_iterator;
+			typedef ptrdiff_t							difference_type;
+			typedef size_t								size_type;
+
+		private:
+
+			typedef char	requires_trivially_copyable[
+				is_trivially_copyable<T>::value ? 1 : -1];
+
+			pointer			_head;
+			size_type		_size;
+			size_type		_capacity;
+			int				_fd;
+			mmap_mode		_mode;
+
+			mmap_vector(const mmap_vector&);
+			mmap_vector& operator=(const mmap_vector&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty vector backed by anonymous memory.
+			*/
+			mmap_vector()
+			: _head(NULL), _size(0), _capacity(0), _fd(-1),
+				_mode(mmap_copy_on_write) {}
+
+			/**
+			 * @brief Constructs a vector mapping the file at path.
+			 * @see mmap_vector::open
+			*/
+			explicit mmap_vector(const char* path, mmap_mode mode = mmap_read_only)
+			: _head(NULL), _size(0), _capacity(0), _fd(-1),
+				_mode(mmap_copy_on_write)
+			{
+				this->open(path, mode);
+			}
+
+			/**
+			 * @brief Unmaps the elements and closes the file, as close does,
+			 * but a failure to trim the file is ignored.
+			*/
+			~mmap_vector()
+			{
+				this->release();
+			}
+
+/*
+** ----------------------------------- FILE ------------------------------------
+*/
+
+			/**
+			 * @brief Closes the current mapping, then maps the file at path.
+			 * Its size must be a multiple of sizeof(T). In mmap_read_write
+			 * mode the file is created if it does not exist.
+			 * @throw std::runtime_error if the previous file cannot be
+			 * trimmed, or the file cannot be opened or mapped.
+			*/
+			void open(const char* path, mmap_mode mode = mmap_read_only)
+			{
+				struct stat	st;
+				int			fd;
+
+				this->close();
+				fd = ::open(path, mode == mmap_read_write ? O_RDWR | O_CREAT
+					: O_RDONLY, 0644);
+				if (fd < 0)
+					throw_errno("mmap_vector: open");
+				if (fstat(fd, &st) < 0)
+				{
+					::close(fd);
+					throw_errno("mmap_vector: fstat");
+				}
+				if (st.st_size % sizeof(T) != 0)
+				{
+					::close(fd);
+					throw std::runtime_error("mmap_vector: file size is not a "
+						"multiple of the element size");
+				}
+				_fd = fd;
+				_mode = mode;
+				if (st.st_size == 0)
+					return ;
+				try
+				{
+					_head = this->map(st.st_size);
+				}
+				catch (...)
+				{
+					::close(fd);
+					_fd = -1;
+					_mode = mmap_copy_on_write;
+					throw;
+				}
+				_size = _capacity = st.st_size / sizeof(T);
+			}
+
+			/**
+			 * @brief Unmaps the elements and closes the file. In
+			 * mmap_read_write mode the file is first trimmed to size()
+			 * elements. The vector is then empty and backed by anonymous
+			 * memory, even if trimming failed.
+			 * @throw std::runtime_error if the file cannot be trimmed.
+			*/
+			void close()
+			{
+				if (!this->release())
+					throw_errno("mmap_vector: ftruncate");
+			}
+
+			/**
+			 * @brief Writes the modified pages back to the file and waits for
+			 * the write to complete. Does nothing unless the vector maps a
+			 * file in mmap_read_write mode.
+			 * @throw std::runtime_error if msync fails.
+			*/
+			void sync()
+			{
+				if (_fd < 0 || _mode != mmap_read_write || _head == NULL)
+					return ;
+				if (msync(_head, _capacity * sizeof(T), MS_SYNC) < 0)
+					throw_errno("mmap_vector: msync");
+			}
+
+			bool is_open() const { return (_fd >= 0); }
+			mmap_mode mode() const { return (_mode); }
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(_head)); }
+			const_iterator begin() const { return (const_iterator(_head)); }
+			iterator end() { return (iterator(_head + _size)); }
+			const_iterator end() const { return (const_iterator(_head + _size)); }
+
+			reverse_iterator rbegin()
+			{
+				return (reverse_iterator(this->end()));
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(iterator(_head + _size)));
+			}
+
+			reverse_iterator rend()
+			{
+				return (reverse_iterator(this->begin()));
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(iterator(_head)));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			size_type size() const { return (_size); }
+			size_type capacity() const { return (_capacity); }
+			bool empty() const { return (_size == 0); }
+
+			size_type max_size() const
+			{
+				return (std::numeric_limits<off_t>::max() / sizeof(T));
+			}
+
+			/**
+			 * @brief Makes room for at least n elements. In mmap_read_write
+			 * mode the file is extended with ftruncate and mapped again,
+			 * otherwise the elements move to anonymous memory.
+			 * @throw std::length_error if n is greater than max_size,
+			 * std::logic_error on a read-only mapping, std::runtime_error if
+			 * the file cannot be extended or mapped.
+			*/
+			void reserve(size_type n)
+			{
+				if (n <= _capacity)
+					return ;
+				if (n > this->max_size())
+					throw std::length_error("resized above max_size");
+				this->check_writable();
+				size_t	bytes = n * sizeof(T);
+				pointer	p;
+
+				if (_mode == mmap_read_write)
+				{
+					if (ftruncate(_fd, bytes) < 0)
+						throw_errno("mmap_vector: ftruncate");
+					p = this->map(bytes);
+				}
+				else
+				{
+					void*	q = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (q == MAP_FAILED)
+						throw_errno("mmap_vector: mmap");
+					p = static_cast<pointer>(q);
+					if (_size)
+						memcpy(p, _head, _size * sizeof(T));
+				}
+				if (_head)
+					munmap(_head, _capacity * sizeof(T));
+				_head = p;
+				_capacity = n;
+			}
+
+			void resize(size_type n, value_type val = value_type())
+			{
+				this->check_writable();
+				if (n > _capacity)
+					this->reserve(this->grow(n));
+				for (size_type i = _size; i < n; i++)
+					_head[i] = val;
+				_size = n;
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type n) { return (_head[n]); }
+			const_reference operator[](size_type n) const { return (_head[n]); }
+
+			reference at(size_type n)
+			{
+				if (n >= _size)
+					throw std::out_of_range("out-of-range");
+				return (_head[n]);
+			}
+
+			const_reference at(size_type n) const
+			{
+				if (n >= _size)
+					throw std::out_of_range("out-of-range");
+				return (_head[n]);
+			}
+
+			reference front() { return (_head[0]); }
+			const_reference front() const { return (_head[0]); }
+			reference back() { return (_head[_size - 1]); }
+			const_reference back() const { return (_head[_size - 1]); }
+			pointer data() { return (_head); }
+			const_pointer data() const { return (_head); }
+
+/*
+** --------------------------------- MODIFIERS ---------------------------------
+*/
+
+			void push_back(const value_type& val)
+			{
+				this->check_writable();
+				if (_size == _capacity)
+				{
+					value_type	tmp = val;
+					this->reserve(this->grow(_size + 1));
+					_head[_size++] = tmp;
+					return ;
+				}
+				_head[_size++] = val;
+			}
+
+			void pop_back()
+			{
+				this->check_writable();
+				_size--;
+			}
+
+			void clear()
+			{
+				this->check_writable();
+				_size = 0;
+			}
+
+			void swap(mmap_vector& x)
+			{
+				swap(_head, x._head);
+				swap(_size, x._size);
+				swap(_capacity, x._capacity);
+				swap(_fd, x._fd);
+				swap(_mode, x._mode);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			static void throw_errno(const char* what)
+			{
+				throw std::runtime_error(std::string(what) + ": "
+					+ strerror(errno));
+			}
+
+			void check_writable() const
+			{
+				if (_mode == mmap_read_only)
+					throw std::logic_error("mmap_vector: read-only mapping");
+			}
+
+			/**
+			 * @brief Computes the capacity to grow to when required elements
+			 * no longer fit, as decided by the growth policy.
+			*/
+			size_type grow(size_type required) const
+			{
+				size_type	new_capacity = growth_policy::next_capacity(_capacity,
+					required, sizeof(value_type));
+
+				if (new_capacity < required || new_capacity > this->max_size())
+					new_capacity = this->max_size();
+				return (new_capacity);
+			}
+
+			/**
+			 * @brief Unmaps the elements and closes the file, trimming it to
+			 * size() elements in mmap_read_write mode, without throwing.
+			 * @return false if the file could not be trimmed, errno then
+			 * holding the reason.
+			*/
+			bool release()
+			{
+				bool	trimmed = true;
+
+				if (_head)
+					munmap(_head, _capacity * sizeof(T));
+				if (_fd >= 0)
+				{
+					if (_mode == mmap_read_write
+						&& ftruncate(_fd, _size * sizeof(T)) < 0)
+						trimmed = false;
+					int	err = errno;
+					::close(_fd);
+					errno = err;
+				}
+				_head = NULL;
+				_size = 0;
+				_capacity = 0;
+				_fd = -1;
+				_mode = mmap_copy_on_write;
+				return (trimmed);
+			}
+
+			/**
+			 * @brief Maps the first bytes of the file with the protection and
+			 * sharing of the current mode.
+			*/
+			pointer map(size_t bytes) const
+			{
+				int		prot = PROT_READ;
+				int		flags = MAP_SHARED;
+
+				if (_mode != mmap_read_only)
+					prot |= PROT_WRITE;
+				if (_mode == mmap_copy_on_write)
+					flags = MAP_PRIVATE;
+				void*	p = mmap(NULL, bytes, prot, flags, _fd, 0);
+				if (p == MAP_FAILED)
+					throw_errno("mmap_vector: mmap");
+				return (static_cast<pointer>(p));
+			}
+
+			template<class U>
+			void swap(U& u1, U& u2)
+			{
+				U tmp = u2;
+				u2 = u1;
+				u1 = tmp;
+			}
+	};
+
+	template <class T, class Growth>
+	void swap(mmap_vector<T,Growth>& x, mmap_vector<T,Growth>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* *************************************************** MMAP_VECTOR_HPP */
@@ -0,0 +1,336 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mpmc_queue.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/14 16:40:05 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/14 16:40:05 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MPMC_QUEUE_HPP
+# define MPMC_QUEUE_HPP
+
+# include <new>
+# include <memory>
+# include "atomic.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Multi-producer/multi-consumer queues are bounded, lock-free FIFO
+	 * queues any number of threads can push to and pop from (Dmitry Vyukov's
+	 * design). Every cell carries a sequence number telling whether it is
+	 * ready to be written or read for a given lap of the ring, so producers
+	 * and consumers only contend on their own position counter.
+	 * @tparam T Type of the elements.
+	 * @tparam Alloc Type of the allocator object used to allocate the cells.
+	*/
+	template <class T, class Alloc = std::allocator<T> >
+	class mpmc_queue
+	{
+		/*
+		** A hole is a cell whose producer failed to copy its element: it is
+		** published like a full cell, and consumers release it and move on.
+		*/
+		struct Cell
+		{
+			ft::atomic<size_t>	sequence;
+			bool				hole;
+			char				storage[sizeof(T)]
+				__attribute__((aligned(__alignof__(T))));
+
+			explicit Cell(size_t seq) : sequence(seq), hole(false) {}
+			T*	val() { return (reinterpret_cast<T*>(storage)); }
+		};
+
+		public:
+
+			typedef T									value_type;
+			typedef Alloc								allocator_type;
+			typedef typename Alloc::template
+			rebind<Cell>::other							Cell_allocator;
+			typedef typename allocator_type::reference	reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef size_t								size_type;
+
+		private:
+
+			/* Read-only once constructed, shared by every thread. */
+			size_type				_mask;
+			Cell*					_cells;
+			allocator_type			_alloc;
+			char					_pad0[FT_CACHELINE_SIZE];
+			ft::atomic<size_type>	_enqueue_pos;
+			char					_pad1[FT_CACHELINE_SIZE];
+			ft::atomic<size_type>	_dequeue_pos;
+			char					_pad2[FT_CACHELINE_SIZE];
+
+			mpmc_queue(const mpmc_queue&);
+			mpmc_queue& operator=(const mpmc_queue&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty queue.
+			 * @param capacity Minimum number of elements the queue can hold,
+			 * rounded up to a power of two (at least 2).
+			 * @param alloc Allocator object.
+			*/
+			explicit mpmc_queue(size_type capacity,
+				const allocator_type& alloc = allocator_type())
+			: _mask(2), _cells(NULL), _alloc(alloc), _enqueue_pos(0),
+				_dequeue_pos(0)
+			{
+				while (_mask < capacity)
+					_mask <<= 1;
+				_cells = Cell_allocator(_alloc).allocate(_mask);
+				for (size_type i = 0; i < _mask; i++)
+					new (&_cells[i]) Cell(i);
+				_mask--;
+			}
+
+			/**
+			 * @brief Destroys the remaining elements and releases the cells.
+			 * No thread may use the queue anymore.
+			*/
+			~mpmc_queue()
+			{
+				size_type	tail = _enqueue_pos.load(memory_order_acquire);
+
+				for (size_type i = _dequeue_pos.load(memory_order_acquire);
+					i != tail; i++)
+					if (!_cells[i & _mask].hole)
+						_alloc.destroy(_cells[i & _mask].val());
+				for (size_type i = 0; i <= _mask; i++)
+					_cells[i].~Cell();
+				Cell_allocator(_alloc).deallocate(_cells, _mask + 1);
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			/**
+			 * @brief Returns whether the queue is empty. The answer may be
+			 * outdated on return if other threads use the queue.
+			*/
+			bool empty() const
+			{
+				return (this->size() == 0);
+			}
+
+			/**
+			 * @brief Returns the number of elements in the queue. The answer
+			 * may be outdated on return if other threads use the queue.
+			*/
+			size_type size() const
+			{
+				size_type	head = _dequeue_pos.load(memory_order_acquire);
+				size_type	tail = _enqueue_pos.load(memory_order_acquire);
+
+				return (tail > head ? tail - head : 0);
+			}
+
+			size_type capacity() const
+			{
+				return (_mask + 1);
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Inserts a copy of val at the end of the queue, if there
+			 * is room for it.
+			 * @return true if the element was inserted, false if the queue was
+			 * full.
+			 * @throw If copying val throws, the cell it claimed is published
+			 * as a hole, which consumers skip, and the exception propagates.
+			*/
+			bool try_push(const value_type& val)
+			{
+				size_type	pos = _enqueue_pos.load(memory_order_relaxed);
+				Cell*		cell;
+
+				for (;;)
+				{
+					cell = &_cells[pos & _mask];
+					size_type	seq = cell->sequence.load(memory_order_acquire);
+					ptrdiff_t	diff = static_cast<ptrdiff_t>(seq - pos);
+					if (diff == 0)
+					{
+						if (_enqueue_pos.compare_exchange(pos, pos + 1,
+							memory_order_relaxed, memory_order_relaxed))
+							break;
+					}
+					else if (diff < 0)
+						return (false);
+					else
+						pos = _enqueue_pos.load(memory_order_relaxed);
+				}
+				try
+				{
+					_alloc.construct(cell->val(), val);
+				}
+				catch (...)
+				{
+					cell->hole = true;
+					cell->sequence.store(pos + 1, memory_order_release);
+					throw;
+				}
+				cell->sequence.store(pos + 1, memory_order_release);
+				return (true);
+			}
+
+			/**
+			 * @brief Inserts a copy of val at the end of the queue, waiting
+			 * for a consumer to make room if the queue is full.
+			*/
+			void push(const value_type& val)
+			{
+				unsigned	spins = 0;
+
+				while (!this->try_push(val))
+					cpu_relax(spins);
+			}
+
+			/**
+			 * @brief Moves the oldest element of the queue into out, if any.
+			 * @return true if an element was popped, false if the queue was
+			 * empty.
+			 * @throw If copying the element into out throws, the element is
+			 * destroyed and its cell released before the exception
+			 * propagates, so the element is lost.
+			*/
+			bool try_pop(value_type& out)
+			{
+				size_type	pos;
+				Cell*		cell = this->claim(pos, false);
+
+				if (cell == NULL)
+					return (false);
+				try
+				{
+					out = *cell->val();
+				}
+				catch (...)
+				{
+					this->vacate(cell, pos);
+					throw;
+				}
+				this->vacate(cell, pos);
+				return (true);
+			}
+
+			/**
+			 * @brief Returns a reference to the oldest element of the queue.
+			 * Only meaningful when a single thread consumes the queue: with
+			 * several consumers, another one may pop the element at any time,
+			 * use try_pop instead. Calling this function on an empty queue
+			 * causes undefined behavior.
+			*/
+			reference front()
+			{
+				size_type	pos = _dequeue_pos.load(memory_order_relaxed);
+				unsigned	spins = 0;
+				Cell*		cell;
+
+				for (;;)
+				{
+					cell = &_cells[pos & _mask];
+					while (cell->sequence.load(memory_order_acquire) != pos + 1)
+						cpu_relax(spins);
+					if (!cell->hole)
+						return (*cell->val());
+					if (_dequeue_pos.compare_exchange(pos, pos + 1,
+						memory_order_relaxed, memory_order_relaxed))
+						this->vacate(cell, pos);
+					pos = _dequeue_pos.load(memory_order_relaxed);
+				}
+			}
+
+			/**
+			 * @brief Removes the oldest element of the queue, waiting for one
+			 * to be pushed if the queue is empty.
+			*/
+			void pop()
+			{
+				size_type	pos;
+				Cell*		cell = this->claim(pos, true);
+
+				this->vacate(cell, pos);
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			/**
+			 * @brief Claims the oldest full cell, releasing the holes found on
+			 * the way.
+			 * @param pos Set to the position of the claimed cell.
+			 * @param wait Whether to wait for an element if the queue is
+			 * empty.
+			 * @return The claimed cell, or NULL if the queue is empty and wait
+			 * is false.
+			*/
+			Cell*	claim(size_type& pos, bool wait)
+			{
+				unsigned	spins = 0;
+				Cell*		cell;
+
+				pos = _dequeue_pos.load(memory_order_relaxed);
+				for (;;)
+				{
+					cell = &_cells[pos & _mask];
+					size_type	seq = cell->sequence.load(memory_order_acquire);
+					ptrdiff_t	diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+					if (diff == 0)
+					{
+						if (_dequeue_pos.compare_exchange(pos, pos + 1,
+							memory_order_relaxed, memory_order_relaxed))
+						{
+							if (!cell->hole)
+								return (cell);
+							this->vacate(cell, pos);
+							pos = _dequeue_pos.load(memory_order_relaxed);
+						}
+					}
+					else if (diff < 0 && !wait)
+						return (NULL);
+					else
+					{
+						if (diff < 0)
+							cpu_relax(spins);
+						pos = _dequeue_pos.load(memory_order_relaxed);
+					}
+				}
+			}
+
+			/**
+			 * @brief Destroys the element of a claimed cell, if it is not a
+			 * hole, and hands the cell over to the producers of the next lap.
+			*/
+			void	vacate(Cell* cell, size_type pos)
+			{
+				if (cell->hole)
+					cell->hole = false;
+				else
+					_alloc.destroy(cell->val());
+				cell->sequence.store(pos + _mask + 1, memory_order_release);
+			}
+	};
+}
+
+#endif /* **************************************************** MPMC_QUEUE_HPP */
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mutex.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/12 14:31:50 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/12 14:31:50 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MUTEX_HPP
+# define MUTEX_HPP
+
+# include <pthread.h>
+
+namespace ft
+{
+	/**
+	 * @brief Non-recursive exclusive lock, wrapping a pthread mutex.
+	*/
+	class mutex
+	{
+		private:
+
+			pthread_mutex_t	_mutex;
+
+			mutex(const mutex&);
+			mutex& operator=(const mutex&);
+
+		public:
+
+			mutex() { pthread_mutex_init(&_mutex, NULL); }
+			~mutex() { pthread_mutex_destroy(&_mutex); }
+
+			void lock() { pthread_mutex_lock(&_mutex); }
+			void unlock() { pthread_mutex_unlock(&_mutex); }
+			pthread_mutex_t* native_handle() { return (&_mutex); }
+	};
+
+	/**
+	 * @brief Condition variable, wrapping a pthread condition. Waiting
+	 * releases the given mutex, which must be locked by the caller, and locks
+	 * it again before returning. Wake-ups may be spurious, so waits belong in
+	 * a loop checking the condition.
+	*/
+	class condition_variable
+	{
+		private:
+
+			pthread_cond_t	_cond;
+
+			condition_variable(const condition_variable&);
+			condition_variable& operator=(const condition_variable&);
+
+		public:
+
+			condition_variable() { pthread_cond_init(&_cond, NULL); }
+			~condition_variable() { pthread_cond_destroy(&_cond); }
+
+			void wait(mutex& m) { pthread_cond_wait(&_cond, m.native_handle()); }
+			void notify_one() { pthread_cond_signal(&_cond); }
+			void notify_all() { pthread_cond_broadcast(&_cond); }
+	};
+
+	/**
+	 * @brief Reader-writer lock, wrapping a pthread rwlock. Any number of
+	 * threads may hold it shared, or a single thread may hold it exclusively.
+	*/
+	class shared_mutex
+	{
+		private:
+
+			pthread_rwlock_t	_rwlock;
+
+			shared_mutex(const shared_mutex&);
+			shared_mutex& operator=(const shared_mutex&);
+
+		public:
+
+			shared_mutex() { pthread_rwlock_init(&_rwlock, NULL); }
+			~shared_mutex() { pthread_rwlock_destroy(&_rwlock); }
+
+			void lock() { pthread_rwlock_wrlock(&_rwlock); }
+			void unlock() { pthread_rwlock_unlock(&_rwlock); }
+			void lock_shared() { pthread_rwlock_rdlock(&_rwlock); }
+			void unlock_shared() { pthread_rwlock_unlock(&_rwlock); }
+	};
+
+	/**
+	 * @brief Holds an exclusive lock on the given mutex for the lifetime of
+	 * the guard.
+	*/
+	template <class Mutex>
+	class lock_guard
+	{
+		private:
+
+			Mutex&	_m;
+
+			lock_guard(const lock_guard&);
+			lock_guard& operator=(const lock_guard&);
+
+		public:
+
+			explicit lock_guard(Mutex& m) : _m(m) { _m.lock(); }
+			~lock_guard() { _m.unlock(); }
+	};
+
+	/**
+	 * @brief Holds a shared lock on the given mutex for the lifetime of the
+	 * guard.
+	*/
+	template <class Mutex>
+	class shared_lock_guard
+	{
+		private:
+
+			Mutex&	_m;
+
+			shared_lock_guard(const shared_lock_guard&);
+			shared_lock_guard& operator=(const shared_lock_guard&);
+
+		public:
+
+			explicit shared_lock_guard(Mutex& m) : _m(m) { _m.lock_shared(); }
+			~shared_lock_guard() { _m.unlock_shared(); }
+	};
+}
+
+#endif /* ********************************************************* MUTEX_HPP */
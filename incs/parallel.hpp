@@ -0,0 +1,421 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parallel.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/22 13:48:19 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/22 13:48:19 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PARALLEL_HPP
+# define PARALLEL_HPP
+
+# include <algorithm>
+# include <iterator>
+# include <functional>
+# include <stdexcept>
+# include "thread_pool.hpp"
+# include "vector.hpp"
+
+/*
+** Smallest number of elements worth handing to a task. Ranges shorter than
+** twice this run on the calling thread.
+*/
+# ifndef FT_PARALLEL_GRAIN
+#  define FT_PARALLEL_GRAIN 4096
+# endif
+
+/*
+** Number of tasks created per thread of the pool, so that threads finishing
+** early can pick up work from slower ones.
+*/
+# ifndef FT_PARALLEL_TASKS_PER_THREAD
+#  define FT_PARALLEL_TASKS_PER_THREAD 4
+# endif
+
+namespace ft
+{
+	/*
+	** The parallel algorithms split a random access range into chunks, run
+	** one task per chunk on a thread_pool and wait for them. Each task works
+	** on its own copy of the function object. If a task throws, the algorithm
+	** throws std::runtime_error once all tasks are done, and the range is
+	** left in an unspecified state.
+	*/
+
+	/**
+	 * @brief Number of chunks to split n elements into on pool.
+	*/
+	inline size_t	parallel_chunks(const thread_pool& pool, size_t n)
+	{
+		size_t	chunks = pool.concurrency() * FT_PARALLEL_TASKS_PER_THREAD;
+		size_t	max_chunks = n / FT_PARALLEL_GRAIN;
+
+		if (chunks > max_chunks)
+			chunks = max_chunks;
+		return (chunks > 0 ? chunks : 1);
+	}
+
+	/**
+	 * @brief Runs Job::run on every job, in parallel on pool. A single job
+	 * runs on the calling thread, and reports a throw the same way as a
+	 * pooled one.
+	 * @throw std::runtime_error if a job threw. If a job cannot be queued,
+	 * the jobs already queued are waited for and the error is rethrown.
+	*/
+	template <class Job>
+	void	parallel_run(thread_pool& pool, ft::vector<Job>& jobs)
+	{
+		thread_pool::task_group	group;
+
+		if (jobs.size() == 1)
+		{
+			try
+			{
+				Job::run(&jobs[0]);
+			}
+			catch (...)
+			{
+				throw std::runtime_error("thread_pool: a task threw");
+			}
+			return ;
+		}
+		try
+		{
+			for (size_t i = 0; i < jobs.size(); i++)
+				pool.submit(group, &Job::run, &jobs[i]);
+		}
+		catch (...)
+		{
+			try
+			{
+				pool.wait(group);
+			}
+			catch (...)
+			{
+			}
+			throw;
+		}
+		pool.wait(group);
+	}
+
+	template <class RandomIt, class Function>
+	struct Parallel_for_each_job
+	{
+		RandomIt	first;
+		RandomIt	last;
+		Function	f;
+
+		Parallel_for_each_job(RandomIt b, RandomIt e, Function fn)
+		: first(b), last(e), f(fn) {}
+
+		static void	run(void* arg)
+		{
+			Parallel_for_each_job*	job = static_cast<Parallel_for_each_job*>(arg);
+
+			for (RandomIt it = job->first; it != job->last; ++it)
+				job->f(*it);
+		}
+	};
+
+	template <class RandomIt, class OutputIt, class UnaryOperation>
+	struct Parallel_transform_job
+	{
+		RandomIt		first;
+		RandomIt		last;
+		OutputIt		out;
+		UnaryOperation	op;
+
+		Parallel_transform_job(RandomIt b, RandomIt e, OutputIt o,
+			UnaryOperation fn)
+		: first(b), last(e), out(o), op(fn) {}
+
+		static void	run(void* arg)
+		{
+			Parallel_transform_job*	job = static_cast<Parallel_transform_job*>(arg);
+			OutputIt				out = job->out;
+
+			for (RandomIt it = job->first; it != job->last; ++it, ++out)
+				*out = job->op(*it);
+		}
+	};
+
+	template <class RandomIt, class T, class BinaryOperation>
+	struct Parallel_reduce_job
+	{
+		RandomIt		first;
+		RandomIt		last;
+		BinaryOperation	op;
+		T				result;
+
+		Parallel_reduce_job(RandomIt b, RandomIt e, BinaryOperation fn,
+			const T& init)
+		: first(b), last(e), op(fn), result(init) {}
+
+		static void	run(void* arg)
+		{
+			Parallel_reduce_job*	job = static_cast<Parallel_reduce_job*>(arg);
+			RandomIt				it = job->first;
+
+			job->result = *it;
+			for (++it; it != job->last; ++it)
+				job->result = job->op(job->result, *it);
+		}
+	};
+
+	template <class RandomIt, class Compare>
+	struct Parallel_sort_job
+	{
+		RandomIt	first;
+		RandomIt	last;
+		Compare		comp;
+
+		Parallel_sort_job(RandomIt b, RandomIt e, Compare c)
+		: first(b), last(e), comp(c) {}
+
+		static void	run(void* arg)
+		{
+			Parallel_sort_job*	job = static_cast<Parallel_sort_job*>(arg);
+
+			std::sort(job->first, job->last, job->comp);
+		}
+	};
+
+	template <class InputIt, class OutputIt, class Compare>
+	struct Parallel_merge_job
+	{
+		InputIt		first1;
+		InputIt		last1;
+		InputIt		first2;
+		InputIt		last2;
+		OutputIt	out;
+		Compare		comp;
+
+		Parallel_merge_job(InputIt b1, InputIt e1, InputIt b2, InputIt e2,
+			OutputIt o, Compare c)
+		: first1(b1), last1(e1), first2(b2), last2(e2), out(o), comp(c) {}
+
+		static void	run(void* arg)
+		{
+			Parallel_merge_job*	job = static_cast<Parallel_merge_job*>(arg);
+
+			std::merge(job->first1, job->last1, job->first2, job->last2,
+				job->out, job->comp);
+		}
+	};
+
+	/**
+	 * @brief Merges the sorted runs of in, delimited by bounds, two by two
+	 * into out, and updates bounds to delimit the merged runs. Each merge is
+	 * split into pieces of about the same length: the first run is cut at
+	 * regular intervals and the second one where its elements stop comparing
+	 * less than the cut, so pieces are independent and the merge stays stable.
+	*/
+	template <class InputIt, class OutputIt, class Compare>
+	void	parallel_merge_round(thread_pool& pool, InputIt in, OutputIt out,
+		ft::vector<size_t>& bounds, size_t tasks, Compare comp)
+	{
+		typedef Parallel_merge_job<InputIt, OutputIt, Compare>	Job;
+		size_t				runs = bounds.size() - 1;
+		size_t				pairs = (runs + 1) / 2;
+		size_t				pieces = (tasks > pairs ? tasks / pairs : 1);
+		ft::vector<Job>		jobs;
+		ft::vector<size_t>	merged;
+
+		jobs.reserve(pairs * pieces);
+		merged.reserve(pairs + 1);
+		for (size_t p = 0; p < runs; p += 2)
+		{
+			size_t	lo1 = bounds[p];
+			size_t	hi1 = bounds[p + 1];
+			size_t	lo2 = hi1;
+			size_t	hi2 = (p + 2 <= runs ? bounds[p + 2] : hi1);
+			size_t	a = lo1;
+			size_t	b = lo2;
+
+			merged.push_back(lo1);
+			for (size_t i = 1; i <= pieces; i++)
+			{
+				size_t	next_a = lo1 + (hi1 - lo1) * i / pieces;
+				size_t	next_b = hi2;
+				if (i < pieces)
+					next_b = std::lower_bound(in + lo2, in + hi2, in[next_a],
+						comp) - in;
+				jobs.push_back(Job(in + a, in + next_a, in + b, in + next_b,
+					out + (lo1 + (a - lo1) + (b - lo2)), comp));
+				a = next_a;
+				b = next_b;
+			}
+		}
+		merged.push_back(bounds[runs]);
+		parallel_run(pool, jobs);
+		bounds.swap(merged);
+	}
+
+/*
+** -------------------------------- ALGORITHMS ---------------------------------
+*/
+
+	/**
+	 * @brief Applies f to every element of [first,last), in parallel on
+	 * pool. The order in which elements are visited is unspecified.
+	*/
+	template <class RandomIt, class Function>
+	void	parallel_for_each(RandomIt first, RandomIt last, Function f,
+		thread_pool& pool)
+	{
+		typedef Parallel_for_each_job<RandomIt, Function>	Job;
+		size_t			n = last - first;
+		size_t			chunks = parallel_chunks(pool, n);
+		ft::vector<Job>	jobs;
+
+		jobs.reserve(chunks);
+		for (size_t i = 0; i < chunks; i++)
+			jobs.push_back(Job(first + n * i / chunks,
+				first + n * (i + 1) / chunks, f));
+		parallel_run(pool, jobs);
+	}
+
+	template <class RandomIt, class Function>
+	void	parallel_for_each(RandomIt first, RandomIt last, Function f)
+	{
+		parallel_for_each(first, last, f, default_thread_pool());
+	}
+
+	/**
+	 * @brief Stores op applied to every element of [first,last) in the
+	 * range beginning at out, in parallel on pool.
+	 * @return An iterator past the last element written.
+	*/
+	template <class RandomIt, class OutputIt, class UnaryOperation>
+	OutputIt	parallel_transform(RandomIt first, RandomIt last, OutputIt out,
+		UnaryOperation op, thread_pool& pool)
+	{
+		typedef Parallel_transform_job<RandomIt, OutputIt, UnaryOperation>	Job;
+		size_t			n = last - first;
+		size_t			chunks = parallel_chunks(pool, n);
+		ft::vector<Job>	jobs;
+
+		jobs.reserve(chunks);
+		for (size_t i = 0; i < chunks; i++)
+			jobs.push_back(Job(first + n * i / chunks,
+				first + n * (i + 1) / chunks, out + n * i / chunks, op));
+		parallel_run(pool, jobs);
+		return (out + n);
+	}
+
+	template <class RandomIt, class OutputIt, class UnaryOperation>
+	OutputIt	parallel_transform(RandomIt first, RandomIt last, OutputIt out,
+		UnaryOperation op)
+	{
+		return (parallel_transform(first, last, out, op, default_thread_pool()));
+	}
+
+	/**
+	 * @brief Folds [first,last) into init with op, in parallel on pool. op
+	 * must be associative, the elements are combined in order within each
+	 * chunk and chunks in order, but grouped differently than a sequential
+	 * fold would.
+	 * @return init if the range is empty.
+	*/
+	template <class RandomIt, class T, class BinaryOperation>
+	T	parallel_reduce(RandomIt first, RandomIt last, T init,
+		BinaryOperation op, thread_pool& pool)
+	{
+		typedef Parallel_reduce_job<RandomIt, T, BinaryOperation>	Job;
+		size_t			n = last - first;
+		size_t			chunks = parallel_chunks(pool, n);
+		ft::vector<Job>	jobs;
+
+		if (n == 0)
+			return (init);
+		jobs.reserve(chunks);
+		for (size_t i = 0; i < chunks; i++)
+			jobs.push_back(Job(first + n * i / chunks,
+				first + n * (i + 1) / chunks, op, init));
+		parallel_run(pool, jobs);
+		for (size_t i = 0; i < chunks; i++)
+			init = op(init, jobs[i].result);
+		return (init);
+	}
+
+	template <class RandomIt, class T, class BinaryOperation>
+	T	parallel_reduce(RandomIt first, RandomIt last, T init,
+		BinaryOperation op)
+	{
+		return (parallel_reduce(first, last, init, op, default_thread_pool()));
+	}
+
+	template <class RandomIt, class T>
+	T	parallel_reduce(RandomIt first, RandomIt last, T init)
+	{
+		return (parallel_reduce(first, last, init, std::plus<T>(),
+			default_thread_pool()));
+	}
+
+	/**
+	 * @brief Sorts [first,last) with comp, in parallel on pool: chunks are
+	 * sorted concurrently, then merged two by two through a buffer of the
+	 * same size, each merge being split across the pool. Not stable, as the
+	 * chunks are sorted with std::sort.
+	*/
+	template <class RandomIt, class Compare>
+	void	parallel_sort(RandomIt first, RandomIt last, Compare comp,
+		thread_pool& pool)
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type	value_type;
+		typedef Parallel_sort_job<RandomIt, Compare>				Job;
+		size_t				n = last - first;
+		size_t				chunks = parallel_chunks(pool, n);
+		ft::vector<Job>		jobs;
+		ft::vector<size_t>	bounds;
+
+		if (chunks == 1)
+			return (std::sort(first, last, comp));
+		jobs.reserve(chunks);
+		bounds.reserve(chunks + 1);
+		for (size_t i = 0; i < chunks; i++)
+		{
+			bounds.push_back(n * i / chunks);
+			jobs.push_back(Job(first + n * i / chunks,
+				first + n * (i + 1) / chunks, comp));
+		}
+		bounds.push_back(n);
+		parallel_run(pool, jobs);
+
+		ft::vector<value_type>	buffer(first, last);
+		value_type*				tmp = &buffer[0];
+		bool					in_buffer = false;
+
+		while (bounds.size() > 2)
+		{
+			if (in_buffer)
+				parallel_merge_round(pool, tmp, first, bounds, chunks, comp);
+			else
+				parallel_merge_round(pool, first, tmp, bounds, chunks, comp);
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer)
+			parallel_merge_round(pool, tmp, first, bounds, chunks, comp);
+	}
+
+	template <class RandomIt, class Compare>
+	void	parallel_sort(RandomIt first, RandomIt last, Compare comp)
+	{
+		parallel_sort(first, last, comp, default_thread_pool());
+	}
+
+	template <class RandomIt>
+	void	parallel_sort(RandomIt first, RandomIt last)
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type	value_type;
+
+		parallel_sort(first, last, std::less<value_type>(),
+			default_thread_pool());
+	}
+}
+
+#endif /* ****************************************************** PARALLEL_HPP */
@@ -0,0 +1,252 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   priority_queue.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/24 11:03:52 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/24 11:03:52 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PRIORITY_QUEUE_HPP
+# define PRIORITY_QUEUE_HPP
+
+# include <functional>
+# include <limits>
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Priority queues are a type of container adaptor, specifically
+	 * designed such that its first element is always the greatest of the
+	 * elements it contains, according to some strict weak ordering criterion.
+	 * The elements are kept as a 4-ary heap in the underlying container: each
+	 * node has four children, stored next to each other, which halves the
+	 * height of the tree compared to a binary heap and makes each level of a
+	 * sift down scan a single cache line for small elements.
+	 * @tparam T Type of the elements.
+	 * @tparam Container Type of the internal underlying container object where
+	 * the elements are stored. It must provide random access, front,
+	 * push_back and pop_back.
+	 * @tparam Compare Binary predicate, the top element is one for which it
+	 * returns false against every other element.
+	*/
+	template <class T, class Container = vector<T>,
+		class Compare = std::less<typename Container::value_type> >
+	class priority_queue
+	{
+		public:
+
+			typedef T			value_type;
+			typedef Container	container_type;
+			typedef Compare		value_compare;
+			typedef size_t		size_type;
+
+			static const size_type	arity = 4;
+
+		protected:
+
+			container_type		c;
+			value_compare		comp;
+
+		public:
+
+			/**
+			 * @brief Constructs a priority queue from a copy of ctnr, whose
+			 * elements are arranged into a heap in O(n).
+			 * @param compare Comparison object used to order the heap.
+			 * @param ctnr Container object.
+			*/
+			explicit priority_queue(const value_compare& compare = value_compare(),
+				const container_type& ctnr = container_type())
+			: c(ctnr), comp(compare)
+			{
+				this->make_heap();
+			}
+
+			/**
+			 * @brief range constructor: Constructs a priority queue holding
+			 * the elements of ctnr and those of the range [first,last),
+			 * arranged into a heap in O(n).
+			*/
+			template <class InputIterator>
+			priority_queue(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last,
+				const value_compare& compare = value_compare(),
+				const container_type& ctnr = container_type())
+			: c(ctnr), comp(compare)
+			{
+				for (; first != last; ++first)
+					c.push_back(*first);
+				this->make_heap();
+			}
+
+			priority_queue(const priority_queue& x) : c(x.c), comp(x.comp) {}
+
+			~priority_queue() {}
+
+			priority_queue& operator=(const priority_queue& x)
+			{
+				c = x.c;
+				comp = x.comp;
+				return (*this);
+			}
+
+			/**
+			 * @brief Returns whether the priority queue is empty.
+			*/
+			bool empty() const
+			{
+				return (c.empty());
+			}
+
+			/**
+			 * @brief Returns the number of elements in the priority queue.
+			*/
+			size_type size() const
+			{
+				return (c.size());
+			}
+
+			/**
+			 * @brief Returns a constant reference to the top element, the
+			 * greatest one according to the comparison object.
+			*/
+			const value_type& top() const
+			{
+				return (c.front());
+			}
+
+			/**
+			 * @brief Inserts a copy of val, in O(log n).
+			*/
+			void push(const value_type& val)
+			{
+				c.push_back(val);
+				this->sift_up(c.size() - 1);
+			}
+
+			/**
+			 * @brief Inserts the elements of [first,last). When they are at
+			 * least as many as the elements already queued, the heap is
+			 * rebuilt in O(n) instead of sifting each one up in O(log n).
+			*/
+			template <class InputIterator>
+			void push_range(InputIterator first, InputIterator last)
+			{
+				size_type	before = c.size();
+
+				for (; first != last; ++first)
+					c.push_back(*first);
+				if (c.size() - before >= before)
+					return (this->make_heap());
+				for (size_type i = before; i < c.size(); i++)
+					this->sift_up(i);
+			}
+
+			/**
+			 * @brief Removes the top element, in O(log n).
+			*/
+			void pop()
+			{
+				if (c.size() > 1)
+					c[0] = c.back();
+				c.pop_back();
+				if (!c.empty())
+					this->sift_down(0);
+			}
+
+			void swap(priority_queue& x)
+			{
+				value_compare	tmp = comp;
+
+				c.swap(x.c);
+				comp = x.comp;
+				x.comp = tmp;
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			/**
+			 * @brief Arranges the whole container into a heap, sifting down
+			 * every internal node from the last one: O(n) overall, as most
+			 * nodes are close to the leaves.
+			*/
+			void make_heap()
+			{
+				size_type	n = c.size();
+
+				if (n < 2)
+					return ;
+				for (size_type i = (n - 2) / arity + 1; i-- > 0; )
+					this->sift_down(i);
+			}
+
+			/**
+			 * @brief Moves the element at i up while it is greater than its
+			 * parent. Parents are shifted down into the hole, and the element
+			 * is only written once, at its final position.
+			*/
+			void sift_up(size_type i)
+			{
+				value_type	val = c[i];
+
+				while (i > 0)
+				{
+					size_type	parent = (i - 1) / arity;
+					if (!comp(c[parent], val))
+						break ;
+					c[i] = c[parent];
+					i = parent;
+				}
+				c[i] = val;
+			}
+
+			/**
+			 * @brief Moves the element at i down while one of its children is
+			 * greater, swapping it with the greatest child.
+			*/
+			void sift_down(size_type i)
+			{
+				size_type	n = c.size();
+				value_type	val = c[i];
+
+				while (true)
+				{
+					size_type	first = i * arity + 1;
+					if (first >= n)
+						break ;
+					size_type	last = (n - first > arity ? first + arity : n);
+					size_type	best = first;
+					for (size_type j = first + 1; j < last; j++)
+						if (comp(c[best], c[j]))
+							best = j;
+					if (!comp(val, c[best]))
+						break ;
+					c[i] = c[best];
+					i = best;
+				}
+				c[i] = val;
+			}
+	};
+
+	template <class T, class Container, class Compare>
+	const typename priority_queue<T,Container,Compare>::size_type
+		priority_queue<T,Container,Compare>::arity;
+
+	template <class T, class Container, class Compare>
+	void swap(priority_queue<T,Container,Compare>& x,
+		priority_queue<T,Container,Compare>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************ PRIORITY_QUEUE_HPP */
@@ -0,0 +1,480 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   serialize.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/21 15:40:08 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/21 15:40:08 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SERIALIZE_HPP
+# define SERIALIZE_HPP
+
+# include <algorithm>
+# include <istream>
+# include <ostream>
+# include <stdexcept>
+# include <stdint.h>
+# include <string.h>
+# include "type_traits.hpp"
+# include "vector.hpp"
+# include "list.hpp"
+# include "map.hpp"
+
+/*
+** Number of bytes buffered when a container is not stored contiguously.
+*/
+# ifndef FT_SERIAL_CHUNK
+#  define FT_SERIAL_CHUNK (1UL << 16)
+# endif
+
+namespace ft
+{
+	/*
+	** Binary format, in the byte order of the host:
+	**
+	**   char     magic[4]      "FTSZ"
+	**   uint32   version       1
+	**   uint32   kind          1 vector, 2 list, 3 map, 4 vector<bool>
+	**   uint32   key_size      sizeof(Key) for a map, 0 otherwise
+	**   uint32   value_size    sizeof(T), 8 for a vector<bool>
+	**   uint64   count         number of records
+	**
+	** followed by count records: the elements for a vector or a list, the
+	** key immediately followed by the value for a map, in key order. A
+	** vector<bool> stores its number of elements as a uint64 after the
+	** header, then its packed words as the records. Elements
+	** are stored as their object representation, so they must be trivially
+	** copyable, and a file is only portable between hosts of the same
+	** architecture.
+	*/
+
+	enum serial_kind
+	{
+		serial_vector = 1,
+		serial_list = 2,
+		serial_map = 3,
+		serial_bit_vector = 4
+	};
+
+	struct serial_header
+	{
+		char		magic[4];
+		uint32_t	version;
+		uint32_t	kind;
+		uint32_t	key_size;
+		uint32_t	value_size;
+		uint64_t	count;
+	};
+
+	static const uint32_t	serial_version = 1;
+
+	/**
+	 * @brief Fails to compile unless T is trivially copyable.
+	*/
+	template <class T>
+	struct serial_check
+	{
+		typedef char	requires_trivially_copyable[
+			is_trivially_copyable<T>::value ? 1 : -1];
+	};
+
+	inline void	serial_write(std::ostream& os, const void* p, size_t bytes)
+	{
+		if (!os.write(static_cast<const char*>(p), bytes))
+			throw std::runtime_error("serialize: write failed");
+	}
+
+	inline void	serial_read(std::istream& is, void* p, size_t bytes)
+	{
+		if (!is.read(static_cast<char*>(p), bytes))
+			throw std::runtime_error("serialize: truncated stream");
+	}
+
+	/**
+	 * @brief Returns the number of bytes left in is, or SIZE_MAX when its
+	 * buffer cannot seek (a pipe, a socket).
+	*/
+	inline size_t	serial_remaining(std::istream& is)
+	{
+		std::streambuf*	sb = is.rdbuf();
+		std::streampos	cur = sb->pubseekoff(0, std::ios_base::cur,
+			std::ios_base::in);
+
+		if (cur == std::streampos(-1))
+			return (static_cast<size_t>(-1));
+		std::streampos	end = sb->pubseekoff(0, std::ios_base::end,
+			std::ios_base::in);
+		sb->pubseekpos(cur, std::ios_base::in);
+		if (end == std::streampos(-1) || end < cur)
+			return (static_cast<size_t>(-1));
+		return (static_cast<size_t>(end - cur));
+	}
+
+	inline void	serial_write_header(std::ostream& os, serial_kind kind,
+		size_t key_size, size_t value_size, size_t count)
+	{
+		serial_header	h;
+
+		memcpy(h.magic, "FTSZ", 4);
+		h.version = serial_version;
+		h.kind = kind;
+		h.key_size = key_size;
+		h.value_size = value_size;
+		h.count = count;
+		serial_write(os, h.magic, sizeof(h.magic));
+		serial_write(os, &h.version, sizeof(h.version));
+		serial_write(os, &h.kind, sizeof(h.kind));
+		serial_write(os, &h.key_size, sizeof(h.key_size));
+		serial_write(os, &h.value_size, sizeof(h.value_size));
+		serial_write(os, &h.count, sizeof(h.count));
+	}
+
+	/**
+	 * @brief Reads a header and checks it describes the expected container.
+	 * @return The number of elements that follow, checked against the
+	 * bytes left in the stream when it can seek.
+	 * @throw std::runtime_error if the stream holds something else, or is
+	 * too short for the count it announces.
+	*/
+	inline size_t	serial_read_header(std::istream& is, serial_kind kind,
+		size_t key_size, size_t value_size)
+	{
+		serial_header	h;
+
+		serial_read(is, h.magic, sizeof(h.magic));
+		serial_read(is, &h.version, sizeof(h.version));
+		serial_read(is, &h.kind, sizeof(h.kind));
+		serial_read(is, &h.key_size, sizeof(h.key_size));
+		serial_read(is, &h.value_size, sizeof(h.value_size));
+		serial_read(is, &h.count, sizeof(h.count));
+		if (memcmp(h.magic, "FTSZ", 4) != 0)
+			throw std::runtime_error("serialize: bad magic");
+		if (h.version != serial_version)
+			throw std::runtime_error("serialize: unsupported version");
+		if (h.kind != static_cast<uint32_t>(kind) || h.key_size != key_size
+			|| h.value_size != value_size)
+			throw std::runtime_error("serialize: container type mismatch");
+		if (h.count > static_cast<uint64_t>(static_cast<size_t>(-1)))
+			throw std::runtime_error("serialize: too many elements");
+		if (h.count > serial_remaining(is) / (key_size + value_size))
+			throw std::runtime_error("serialize: truncated stream");
+		return (static_cast<size_t>(h.count));
+	}
+
+	/**
+	 * @brief Reads fixed size records from a stream, FT_SERIAL_CHUNK bytes
+	 * at a time.
+	*/
+	class Serial_reader
+	{
+		public:
+
+			Serial_reader(std::istream& is, size_t record, size_t count)
+			: _is(is), _record(record), _left(count), _pos(0), _len(0),
+				_buffer(chunk_records(record) * record) {}
+
+			bool more() const { return (_pos < _len || _left > 0); }
+
+			/**
+			 * @brief Returns the next record, valid until the following
+			 * call.
+			*/
+			const char*	next()
+			{
+				if (_pos == _len)
+				{
+					size_t	n = std::min(_left, chunk_records(_record));
+					serial_read(_is, &_buffer[0], n * _record);
+					_left -= n;
+					_pos = 0;
+					_len = n * _record;
+				}
+				const char*	p = &_buffer[_pos];
+				_pos += _record;
+				return (p);
+			}
+
+		private:
+
+			std::istream&	_is;
+			size_t			_record;
+			size_t			_left;
+			size_t			_pos;
+			size_t			_len;
+			ft::vector<char>	_buffer;
+
+			static size_t	chunk_records(size_t record)
+			{
+				return (record < FT_SERIAL_CHUNK ? FT_SERIAL_CHUNK / record : 1);
+			}
+	};
+
+	/**
+	 * @brief Input iterator over the key/value records of a Serial_reader,
+	 * fed to map::assign_sorted. Each key is checked to be strictly greater
+	 * than the previous one under Compare as the iterator advances.
+	*/
+	template <class Key, class T, class Compare>
+	class Serial_map_iterator
+	{
+		public:
+
+			typedef ft::pair<const Key, T>	value_type;
+
+			Serial_map_iterator(Serial_reader& reader, const Compare& comp)
+			: _reader(reader), _cur(reader.more() ? reader.next() : NULL),
+				_comp(comp) {}
+
+			value_type operator*() const
+			{
+				Key	k;
+				T	v;
+
+				memcpy(&k, _cur, sizeof(Key));
+				memcpy(&v, _cur + sizeof(Key), sizeof(T));
+				return (value_type(k, v));
+			}
+
+			/**
+			 * @throw std::runtime_error if the next key does not follow
+			 * the current one.
+			*/
+			Serial_map_iterator& operator++()
+			{
+				Key	prev;
+				Key	next;
+
+				memcpy(&prev, _cur, sizeof(Key));
+				_cur = (_reader.more() ? _reader.next() : NULL);
+				if (_cur)
+				{
+					memcpy(&next, _cur, sizeof(Key));
+					if (!_comp(prev, next))
+						throw std::runtime_error("serialize: map keys out of order");
+				}
+				return (*this);
+			}
+
+		private:
+
+			Serial_reader&	_reader;
+			const char*		_cur;
+			Compare			_comp;
+	};
+
+/*
+** ---------------------------------- VECTOR -----------------------------------
+*/
+
+	/**
+	 * @brief Writes v to os as a single contiguous block.
+	 * @throw std::runtime_error if the stream fails.
+	*/
+	template <class T, class Alloc, class Growth>
+	void	serialize(std::ostream& os, const vector<T,Alloc,Growth>& v)
+	{
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		serial_write_header(os, serial_vector, 0, sizeof(T), v.size());
+		if (!v.empty())
+			serial_write(os, &v[0], v.size() * sizeof(T));
+	}
+
+	/**
+	 * @brief Replaces the contents of v with the vector stored in is. The
+	 * elements are read FT_SERIAL_CHUNK bytes at a time and appended, so
+	 * they are never value-initialised first, and a corrupt count on a
+	 * stream that cannot seek fails at the end of the data rather than
+	 * allocating it upfront.
+	 * @throw std::runtime_error if the stream is truncated or does not hold
+	 * a vector of T, or holds more elements than v can.
+	*/
+	template <class T, class Alloc, class Growth>
+	void	deserialize(std::istream& is, vector<T,Alloc,Growth>& v)
+	{
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		size_t	n = serial_read_header(is, serial_vector, 0, sizeof(T));
+
+		if (n > v.max_size())
+			throw std::runtime_error("serialize: too many elements");
+		v.clear();
+		if (!n)
+			return ;
+		if (serial_remaining(is) != static_cast<size_t>(-1))
+			v.reserve(n);
+		ft::vector<T>	chunk(std::min(n,
+			static_cast<size_t>(FT_SERIAL_CHUNK / sizeof(T) + 1)));
+		while (n)
+		{
+			size_t	len = std::min(n, chunk.size());
+			serial_read(is, &chunk[0], len * sizeof(T));
+			v.insert(v.end(), &chunk[0], &chunk[0] + len);
+			n -= len;
+		}
+	}
+
+	/**
+	 * @brief Writes the packed words of a vector<bool> to os.
+	 * @throw std::runtime_error if the stream fails.
+	*/
+	template <class Alloc, class Growth>
+	void	serialize(std::ostream& os, const vector<bool,Alloc,Growth>& v)
+	{
+		uint64_t	size = v.size();
+
+		serial_write_header(os, serial_bit_vector, 0, sizeof(uint64_t),
+			v.num_blocks());
+		serial_write(os, &size, sizeof(size));
+		if (v.num_blocks())
+			serial_write(os, v.data(), v.num_blocks() * sizeof(uint64_t));
+	}
+
+	/**
+	 * @brief Replaces the contents of v with the vector<bool> stored in is,
+	 * appending its words FT_SERIAL_CHUNK bytes at a time.
+	 * @throw std::runtime_error if the stream is truncated or does not hold
+	 * a vector<bool>, or holds more elements than v can.
+	*/
+	template <class Alloc, class Growth>
+	void	deserialize(std::istream& is, vector<bool,Alloc,Growth>& v)
+	{
+		size_t		n = serial_read_header(is, serial_bit_vector, 0,
+			sizeof(uint64_t));
+		uint64_t	size;
+
+		serial_read(is, &size, sizeof(size));
+		if (size / 64 + (size % 64 != 0) != n)
+			throw std::runtime_error("serialize: bad vector<bool> size");
+		if (size > v.max_size())
+			throw std::runtime_error("serialize: too many elements");
+		v.clear();
+		if (!n)
+			return ;
+		if (serial_remaining(is) != static_cast<size_t>(-1))
+			v.reserve(static_cast<size_t>(size));
+		ft::vector<uint64_t>	chunk(std::min(n,
+			static_cast<size_t>(FT_SERIAL_CHUNK / sizeof(uint64_t))));
+		while (n)
+		{
+			size_t	len = std::min(n, chunk.size());
+			serial_read(is, &chunk[0], len * sizeof(uint64_t));
+			v.append_blocks(chunk.begin(), chunk.begin() + len);
+			n -= len;
+		}
+		v.resize(static_cast<size_t>(size));
+	}
+
+/*
+** ----------------------------------- LIST ------------------------------------
+*/
+
+	/**
+	 * @brief Writes l to os, buffering its elements into contiguous chunks.
+	 * @throw std::runtime_error if the stream fails.
+	*/
+	template <class T, class Alloc>
+	void	serialize(std::ostream& os, const list<T,Alloc>& l)
+	{
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		size_t				chunk = FT_SERIAL_CHUNK / sizeof(T) + 1;
+		ft::vector<char>	buffer(chunk * sizeof(T));
+		size_t				len = 0;
+
+		serial_write_header(os, serial_list, 0, sizeof(T), l.size());
+		for (typename list<T,Alloc>::const_iterator it = l.begin();
+			it != l.end(); ++it)
+		{
+			memcpy(&buffer[len * sizeof(T)], &*it, sizeof(T));
+			if (++len == chunk)
+			{
+				serial_write(os, &buffer[0], len * sizeof(T));
+				len = 0;
+			}
+		}
+		if (len)
+			serial_write(os, &buffer[0], len * sizeof(T));
+	}
+
+	/**
+	 * @brief Replaces the contents of l with the list stored in is.
+	 * @throw std::runtime_error if the stream is truncated or does not hold
+	 * a list of T.
+	*/
+	template <class T, class Alloc>
+	void	deserialize(std::istream& is, list<T,Alloc>& l)
+	{
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		size_t			n = serial_read_header(is, serial_list, 0, sizeof(T));
+		Serial_reader	reader(is, sizeof(T), n);
+		T				val;
+
+		l.clear();
+		while (reader.more())
+		{
+			memcpy(&val, reader.next(), sizeof(T));
+			l.push_back(val);
+		}
+	}
+
+/*
+** ------------------------------------ MAP ------------------------------------
+*/
+
+	/**
+	 * @brief Writes m to os as an array of key/value records sorted by key.
+	 * @throw std::runtime_error if the stream fails.
+	*/
+	template <class Key, class T, class Compare, class Alloc>
+	void	serialize(std::ostream& os, const map<Key,T,Compare,Alloc>& m)
+	{
+		(void)sizeof(typename serial_check<Key>::requires_trivially_copyable);
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		size_t				record = sizeof(Key) + sizeof(T);
+		size_t				chunk = FT_SERIAL_CHUNK / record + 1;
+		ft::vector<char>	buffer(chunk * record);
+		size_t				len = 0;
+
+		serial_write_header(os, serial_map, sizeof(Key), sizeof(T), m.size());
+		for (typename map<Key,T,Compare,Alloc>::const_iterator it = m.begin();
+			it != m.end(); ++it)
+		{
+			memcpy(&buffer[len * record], &it->first, sizeof(Key));
+			memcpy(&buffer[len * record + sizeof(Key)], &it->second, sizeof(T));
+			if (++len == chunk)
+			{
+				serial_write(os, &buffer[0], len * record);
+				len = 0;
+			}
+		}
+		if (len)
+			serial_write(os, &buffer[0], len * record);
+	}
+
+	/**
+	 * @brief Replaces the contents of m with the map stored in is. The
+	 * records are already sorted, so the tree is built in O(n) by
+	 * map::assign_sorted instead of being inserted one by one. The stream
+	 * must have been written with the same Compare: the keys are checked to
+	 * be strictly increasing while the tree is built.
+	 * @throw std::runtime_error if the stream is truncated, does not hold
+	 * a map of Key and T, or holds keys out of order or repeated. m is then
+	 * left empty.
+	*/
+	template <class Key, class T, class Compare, class Alloc>
+	void	deserialize(std::istream& is, map<Key,T,Compare,Alloc>& m)
+	{
+		(void)sizeof(typename serial_check<Key>::requires_trivially_copyable);
+		(void)sizeof(typename serial_check<T>::requires_trivially_copyable);
+		size_t			n = serial_read_header(is, serial_map, sizeof(Key),
+			sizeof(T));
+		Serial_reader	reader(is, sizeof(Key) + sizeof(T), n);
+
+		m.assign_sorted(Serial_map_iterator<Key, T, Compare>(reader,
+			m.key_comp()), n);
+	}
+}
+
+#endif /* ***************************************************** SERIALIZE_HPP */
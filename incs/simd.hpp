@@ -0,0 +1,750 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   simd.hpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/23 09:12:55 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/23 09:12:55 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SIMD_HPP
+# define SIMD_HPP
+
+# include <stddef.h>
+# include <stdint.h>
+# include <string.h>
+# include <limits>
+# include "type_traits.hpp"
+
+/*
+** FT_SIMD_X86 is set when SSE2 kernels can be compiled. SSE4.1 and AVX2
+** kernels are then compiled too, and selected at run time on processors
+** supporting them. Define FT_NO_SIMD to only use the portable code.
+*/
+# if !defined(FT_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__) \
+	&& (defined(__x86_64__) || defined(__i386__))
+#  define FT_SIMD_X86 1
+#  include <immintrin.h>
+# endif
+
+namespace ft
+{
+	namespace simd
+	{
+		/**
+		 * @brief Portable version of mismatch, eight bytes at a time.
+		*/
+		inline size_t	mismatch_scalar(const unsigned char* a,
+			const unsigned char* b, size_t i, size_t n)
+		{
+			for (; i + 8 <= n; i += 8)
+				if (memcmp(a + i, b + i, 8) != 0)
+					break ;
+			while (i < n && a[i] == b[i])
+				i++;
+			return (i);
+		}
+
+# ifdef FT_SIMD_X86
+
+		inline size_t	mismatch_sse2(const unsigned char* a,
+			const unsigned char* b, size_t n)
+		{
+			size_t	i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m128i	x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				__m128i	y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				unsigned	mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffffU;
+				if (mask)
+					return (i + __builtin_ctz(mask));
+			}
+			return (mismatch_scalar(a, b, i, n));
+		}
+
+		__attribute__((target("avx2")))
+		inline size_t	mismatch_avx2(const unsigned char* a,
+			const unsigned char* b, size_t n)
+		{
+			size_t	i = 0;
+
+			for (; i + 32 <= n; i += 32)
+			{
+				__m256i	x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+				__m256i	y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+				unsigned	mask = ~static_cast<unsigned>(
+					_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+				if (mask)
+					return (i + __builtin_ctz(mask));
+			}
+			return (i + mismatch_sse2(a + i, b + i, n - i));
+		}
+
+		/**
+		 * @brief Tells whether the processor supports AVX2, checked once.
+		*/
+		inline bool	has_avx2()
+		{
+			static const bool	avx2 = __builtin_cpu_supports("avx2");
+
+			return (avx2);
+		}
+
+		/**
+		 * @brief Tells whether the processor supports SSE4.1, checked once.
+		*/
+		inline bool	has_sse41()
+		{
+			static const bool	sse41 = __builtin_cpu_supports("sse4.1");
+
+			return (sse41);
+		}
+
+		/*
+		** Lane descriptions: for each integral, float and double element
+		** type, the intrinsics broadcasting, comparing and taking the minimum
+		** and maximum of its lanes, on 128-bit (SSE4.1) and 256-bit (AVX2)
+		** registers. 64-bit integral lanes have no min or max instruction
+		** before AVX-512, so they only support comparisons.
+		*/
+
+# define FT_SIMD_SSE41 __attribute__((target("sse4.1"), always_inline))
+# define FT_SIMD_AVX2 __attribute__((target("avx2"), always_inline))
+
+		struct lanes_i8
+		{
+			typedef signed char	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi8(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi8(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epi8(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epi8(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi8(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi8(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epi8(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epi8(a, b)); }
+		};
+
+		struct lanes_u8
+		{
+			typedef unsigned char	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi8(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi8(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epu8(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epu8(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi8(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi8(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epu8(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epu8(a, b)); }
+		};
+
+		struct lanes_i16
+		{
+			typedef short	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi16(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi16(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epi16(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epi16(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi16(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi16(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epi16(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epi16(a, b)); }
+		};
+
+		struct lanes_u16
+		{
+			typedef unsigned short	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi16(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi16(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epu16(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epu16(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi16(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi16(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epu16(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epu16(a, b)); }
+		};
+
+		struct lanes_i32
+		{
+			typedef int	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi32(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi32(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epi32(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epi32(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi32(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi32(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epi32(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epi32(a, b)); }
+		};
+
+		struct lanes_u32
+		{
+			typedef unsigned int	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi32(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi32(a, b)); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_min_epu32(a, b)); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_max_epu32(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi32(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi32(a, b)); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_min_epu32(a, b)); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_max_epu32(a, b)); }
+		};
+
+		struct lanes_64
+		{
+			typedef int64_t	type;
+			static const bool	has_minmax = false;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_set1_epi64x(v)); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_cmpeq_epi64(a, b)); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_set1_epi64x(v)); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_cmpeq_epi64(a, b)); }
+		};
+
+		/*
+		** Floating point lanes live in integer registers, cast for free to
+		** the ps/pd forms. eq is the ordered comparison of operator==: 0.0
+		** equals -0.0 and NaN equals nothing. min and max are called with
+		** the accumulator first and return it when either operand is NaN,
+		** so NaN elements are skipped like the scalar loop skips them; a NaN
+		** first element is left to the caller.
+		*/
+
+		struct lanes_f32
+		{
+			typedef float	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_castps_si128(_mm_set1_ps(v))); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)))); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a)))); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a)))); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_castps_si256(_mm256_set1_ps(v))); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ))); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a)))); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a)))); }
+		};
+
+		struct lanes_f64
+		{
+			typedef double	type;
+			static const bool	has_minmax = true;
+			FT_SIMD_SSE41 static __m128i set1(type v, __m128i) { return (_mm_castpd_si128(_mm_set1_pd(v))); }
+			FT_SIMD_SSE41 static __m128i eq(__m128i a, __m128i b) { return (_mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)))); }
+			FT_SIMD_SSE41 static __m128i min(__m128i a, __m128i b) { return (_mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(b), _mm_castsi128_pd(a)))); }
+			FT_SIMD_SSE41 static __m128i max(__m128i a, __m128i b) { return (_mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(b), _mm_castsi128_pd(a)))); }
+			FT_SIMD_AVX2 static __m256i set1(type v, __m256i) { return (_mm256_castpd_si256(_mm256_set1_pd(v))); }
+			FT_SIMD_AVX2 static __m256i eq(__m256i a, __m256i b) { return (_mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ))); }
+			FT_SIMD_AVX2 static __m256i min(__m256i a, __m256i b) { return (_mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(b), _mm256_castsi256_pd(a)))); }
+			FT_SIMD_AVX2 static __m256i max(__m256i a, __m256i b) { return (_mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(b), _mm256_castsi256_pd(a)))); }
+		};
+
+# undef FT_SIMD_SSE41
+# undef FT_SIMD_AVX2
+
+		/*
+		** Kernels, for 128-bit (SSE4.1) and 256-bit (AVX2) registers. They
+		** only scan the whole registers of the n elements at p and return
+		** how far they got, leaving the last elements to the caller: p is
+		** only read through register loads, never as an array of L::type,
+		** which may be another type than the elements' with the same
+		** representation. The first element matching in a register is found
+		** from the byte mask of the comparison, which has sizeof(type) bits
+		** per element.
+		*/
+
+		/**
+		 * @brief Returns the index of the first element equal to val in the
+		 * whole registers, or the number of elements they hold.
+		*/
+		template <class L>
+		__attribute__((target("sse4.1")))
+		size_t	find_sse41(const char* p, size_t n, typename L::type val)
+		{
+			const size_t	width = 16 / sizeof(val);
+			__m128i			needle = L::set1(val, __m128i());
+			size_t			i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				__m128i		x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+					p + i * sizeof(val)));
+				unsigned	m = _mm_movemask_epi8(L::eq(x, needle));
+				if (m)
+					return (i + __builtin_ctz(m) / sizeof(val));
+			}
+			return (i);
+		}
+
+		template <class L>
+		__attribute__((target("avx2")))
+		size_t	find_avx2(const char* p, size_t n, typename L::type val)
+		{
+			const size_t	width = 32 / sizeof(val);
+			__m256i			needle = L::set1(val, __m256i());
+			size_t			i = 0;
+
+			for (; i + width <= n; i += width)
+			{
+				__m256i		x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+					p + i * sizeof(val)));
+				unsigned	m = _mm256_movemask_epi8(L::eq(x, needle));
+				if (m)
+					return (i + __builtin_ctz(m) / sizeof(val));
+			}
+			return (i);
+		}
+
+		/**
+		 * @brief Returns the number of elements equal to val in the whole
+		 * registers, and sets i to the number of elements they hold.
+		*/
+		template <class L>
+		__attribute__((target("sse4.1")))
+		size_t	count_sse41(const char* p, size_t n, typename L::type val,
+			size_t& i)
+		{
+			const size_t	width = 16 / sizeof(val);
+			__m128i			needle = L::set1(val, __m128i());
+			size_t			bits = 0;
+
+			for (i = 0; i + width <= n; i += width)
+			{
+				__m128i	x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+					p + i * sizeof(val)));
+				bits += __builtin_popcount(_mm_movemask_epi8(L::eq(x, needle)));
+			}
+			return (bits / sizeof(val));
+		}
+
+		template <class L>
+		__attribute__((target("avx2")))
+		size_t	count_avx2(const char* p, size_t n, typename L::type val,
+			size_t& i)
+		{
+			const size_t	width = 32 / sizeof(val);
+			__m256i			needle = L::set1(val, __m256i());
+			size_t			bits = 0;
+
+			for (i = 0; i + width <= n; i += width)
+			{
+				__m256i	x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+					p + i * sizeof(val)));
+				bits += __builtin_popcount(static_cast<unsigned>(
+					_mm256_movemask_epi8(L::eq(x, needle))));
+			}
+			return (bits / sizeof(val));
+		}
+
+		/**
+		 * @brief Folds the lanes of a register, stored at lanes, into the
+		 * smallest (Max false) or greatest (Max true) one.
+		*/
+		template <class T, bool Max>
+		T	minmax_lanes(const T* lanes, size_t width)
+		{
+			T	res = lanes[0];
+
+			for (size_t j = 1; j < width; j++)
+				res = ((Max ? res < lanes[j] : lanes[j] < res) ? lanes[j] : res);
+			return (res);
+		}
+
+		/**
+		 * @brief Returns the smallest (Max false) or greatest (Max true) of
+		 * first and of the elements in the whole registers, and sets i to the
+		 * number of elements they hold.
+		*/
+		template <class L, bool Max>
+		__attribute__((target("sse4.1")))
+		typename L::type	minmax_sse41(const char* p, size_t n,
+			typename L::type first, size_t& i)
+		{
+			typedef typename L::type	type;
+			const size_t	width = 16 / sizeof(type);
+			__m128i			acc = L::set1(first, __m128i());
+			type			lanes[16 / sizeof(type)];
+
+			for (i = 0; i + width <= n; i += width)
+			{
+				__m128i	x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+					p + i * sizeof(type)));
+				acc = (Max ? L::max(acc, x) : L::min(acc, x));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+			return (minmax_lanes<type, Max>(lanes, width));
+		}
+
+		template <class L, bool Max>
+		__attribute__((target("avx2")))
+		typename L::type	minmax_avx2(const char* p, size_t n,
+			typename L::type first, size_t& i)
+		{
+			typedef typename L::type	type;
+			const size_t	width = 32 / sizeof(type);
+			__m256i			acc = L::set1(first, __m256i());
+			type			lanes[32 / sizeof(type)];
+
+			for (i = 0; i + width <= n; i += width)
+			{
+				__m256i	x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+					p + i * sizeof(type)));
+				acc = (Max ? L::max(acc, x) : L::min(acc, x));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+			return (minmax_lanes<type, Max>(lanes, width));
+		}
+
+		/**
+		 * @brief Applies Op to the n words of dst and src, storing the
+		 * result in dst.
+		*/
+		template <class Op>
+		void	bitwise_sse2(uint64_t* dst, const uint64_t* src, size_t n)
+		{
+			size_t	i = 0;
+
+			for (; i + 2 <= n; i += 2)
+			{
+				__m128i	a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+				__m128i	b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Op::sse2(a, b));
+			}
+			for (; i < n; i++)
+				dst[i] = Op::word(dst[i], src[i]);
+		}
+
+		template <class Op>
+		__attribute__((target("avx2")))
+		void	bitwise_avx2(uint64_t* dst, const uint64_t* src, size_t n)
+		{
+			size_t	i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m256i	a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+				__m256i	b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::avx2(a, b));
+			}
+			for (; i < n; i++)
+				dst[i] = Op::word(dst[i], src[i]);
+		}
+
+		/**
+		 * @brief Counts the bits set in n words with the popcnt instruction.
+		*/
+		__attribute__((target("popcnt")))
+		inline size_t	popcount_popcnt(const uint64_t* p, size_t n)
+		{
+			size_t	c = 0;
+
+			for (size_t i = 0; i < n; i++)
+				c += __builtin_popcountll(p[i]);
+			return (c);
+		}
+
+		/**
+		 * @brief Counts the bits set in n words, 32 bytes at a time: each
+		 * nibble is looked up in a table of bit counts with a byte shuffle,
+		 * and the byte counts are summed into 64-bit lanes.
+		*/
+		__attribute__((target("avx2,popcnt")))
+		inline size_t	popcount_avx2(const uint64_t* p, size_t n)
+		{
+			const __m256i	table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+				1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3,
+				1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i	low = _mm256_set1_epi8(0x0f);
+			__m256i			acc = _mm256_setzero_si256();
+			uint64_t		lanes[4];
+			size_t			i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m256i	x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+				__m256i	lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, low));
+				__m256i	hi = _mm256_shuffle_epi8(table,
+					_mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+				acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi),
+					_mm256_setzero_si256()));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+			return (lanes[0] + lanes[1] + lanes[2] + lanes[3]
+				+ popcount_popcnt(p + i, n - i));
+		}
+
+		/**
+		 * @brief Tells whether the processor supports popcnt, checked once.
+		*/
+		inline bool	has_popcnt()
+		{
+			static const bool	popcnt = __builtin_cpu_supports("popcnt");
+
+			return (popcnt);
+		}
+
+# endif
+
+		/*
+		** Bitwise operations over words, applied to a 64-bit word and, when
+		** the kernels are compiled, to an SSE2 or AVX2 register. andnot keeps
+		** the bits of its first operand that are not set in the second.
+		*/
+
+		struct op_and
+		{
+			static uint64_t word(uint64_t a, uint64_t b) { return (a & b); }
+# ifdef FT_SIMD_X86
+			static __m128i sse2(__m128i a, __m128i b) { return (_mm_and_si128(a, b)); }
+			__attribute__((target("avx2"), always_inline))
+			static __m256i avx2(__m256i a, __m256i b) { return (_mm256_and_si256(a, b)); }
+# endif
+		};
+
+		struct op_or
+		{
+			static uint64_t word(uint64_t a, uint64_t b) { return (a | b); }
+# ifdef FT_SIMD_X86
+			static __m128i sse2(__m128i a, __m128i b) { return (_mm_or_si128(a, b)); }
+			__attribute__((target("avx2"), always_inline))
+			static __m256i avx2(__m256i a, __m256i b) { return (_mm256_or_si256(a, b)); }
+# endif
+		};
+
+		struct op_xor
+		{
+			static uint64_t word(uint64_t a, uint64_t b) { return (a ^ b); }
+# ifdef FT_SIMD_X86
+			static __m128i sse2(__m128i a, __m128i b) { return (_mm_xor_si128(a, b)); }
+			__attribute__((target("avx2"), always_inline))
+			static __m256i avx2(__m256i a, __m256i b) { return (_mm256_xor_si256(a, b)); }
+# endif
+		};
+
+		struct op_andnot
+		{
+			static uint64_t word(uint64_t a, uint64_t b) { return (a & ~b); }
+# ifdef FT_SIMD_X86
+			static __m128i sse2(__m128i a, __m128i b) { return (_mm_andnot_si128(b, a)); }
+			__attribute__((target("avx2"), always_inline))
+			static __m256i avx2(__m256i a, __m256i b) { return (_mm256_andnot_si256(b, a)); }
+# endif
+		};
+
+		/**
+		 * @brief Returns the number of bits set in the n words at p.
+		*/
+		inline size_t	popcount(const uint64_t* p, size_t n)
+		{
+# ifdef FT_SIMD_X86
+			if (has_avx2() && has_popcnt())
+				return (popcount_avx2(p, n));
+			if (has_popcnt())
+				return (popcount_popcnt(p, n));
+# endif
+			size_t	c = 0;
+
+			for (size_t i = 0; i < n; i++)
+				c += __builtin_popcountll(p[i]);
+			return (c);
+		}
+
+		/**
+		 * @brief Applies Op (op_and, op_or, op_xor or op_andnot) to the n
+		 * words of dst and src, storing the result in dst.
+		*/
+		template <class Op>
+		void	bitwise(uint64_t* dst, const uint64_t* src, size_t n)
+		{
+# ifdef FT_SIMD_X86
+			if (has_avx2())
+				return (bitwise_avx2<Op>(dst, src, n));
+			return (bitwise_sse2<Op>(dst, src, n));
+# else
+			for (size_t i = 0; i < n; i++)
+				dst[i] = Op::word(dst[i], src[i]);
+# endif
+		}
+
+		/**
+		 * @brief Returns the offset of the first byte differing between the
+		 * n bytes at a and b, or n if they are equal. Uses AVX2 or SSE2
+		 * kernels where available.
+		*/
+		inline size_t	mismatch(const void* a, const void* b, size_t n)
+		{
+			const unsigned char*	x = static_cast<const unsigned char*>(a);
+			const unsigned char*	y = static_cast<const unsigned char*>(b);
+
+# ifdef FT_SIMD_X86
+			if (has_avx2())
+				return (mismatch_avx2(x, y, n));
+			return (mismatch_sse2(x, y, n));
+# else
+			return (mismatch_scalar(x, y, 0, n));
+# endif
+		}
+
+# ifdef FT_SIMD_X86
+
+		/**
+		 * @brief Lanes used for an integral type of Size bytes.
+		*/
+		template <size_t Size, bool Signed> struct lanes_of {};
+		template <> struct lanes_of<1, true> { typedef lanes_i8 type; };
+		template <> struct lanes_of<1, false> { typedef lanes_u8 type; };
+		template <> struct lanes_of<2, true> { typedef lanes_i16 type; };
+		template <> struct lanes_of<2, false> { typedef lanes_u16 type; };
+		template <> struct lanes_of<4, true> { typedef lanes_i32 type; };
+		template <> struct lanes_of<4, false> { typedef lanes_u32 type; };
+		template <> struct lanes_of<8, true> { typedef lanes_64 type; };
+		template <> struct lanes_of<8, false> { typedef lanes_64 type; };
+
+		/**
+		 * @brief Lanes used for an element type T.
+		*/
+		template <class T>
+		struct lanes_for
+		{
+			typedef typename lanes_of<sizeof(T),
+				std::numeric_limits<T>::is_signed>::type	type;
+		};
+		template <> struct lanes_for<float> { typedef lanes_f32 type; };
+		template <> struct lanes_for<double> { typedef lanes_f64 type; };
+
+		template <class L, bool Max>
+		bool	minmax_dispatch(const char* p, size_t n, typename L::type& out,
+			size_t& i, true_type)
+		{
+			if (has_avx2())
+				out = minmax_avx2<L, Max>(p, n, out, i);
+			else if (has_sse41())
+				out = minmax_sse41<L, Max>(p, n, out, i);
+			else
+				return (false);
+			return (true);
+		}
+
+		template <class L, bool Max>
+		bool	minmax_dispatch(const char*, size_t, typename L::type&, size_t&,
+			false_type)
+		{
+			return (false);
+		}
+
+# endif
+
+		/**
+		 * @brief Tells whether the searches below take elements of type T:
+		 * integral types, float and double.
+		*/
+		template <class T>
+		struct has_lanes : public bool_constant<is_integral<T>::value> {};
+		template <> struct has_lanes<float> : public true_type {};
+		template <> struct has_lanes<double> : public true_type {};
+
+		/*
+		** Searches over the n elements at p, T being one of the has_lanes
+		** types. The kernels compare integral elements as their lanes type of
+		** the same size and signedness, which has the same object
+		** representation, and the elements they leave are then scanned here
+		** as T.
+		*/
+
+		/**
+		 * @brief Returns the index of the first element equal to val, or n.
+		*/
+		template <class T>
+		size_t	find(const T* p, size_t n, T val)
+		{
+			size_t	i = 0;
+
+# ifdef FT_SIMD_X86
+			typedef typename lanes_for<T>::type	L;
+			typename L::type					v;
+			const char*										bytes;
+
+			memcpy(&v, &val, sizeof(T));
+			bytes = reinterpret_cast<const char*>(p);
+			if (has_avx2())
+				i = find_avx2<L>(bytes, n, v);
+			else if (has_sse41())
+				i = find_sse41<L>(bytes, n, v);
+# endif
+			while (i < n && !(p[i] == val))
+				i++;
+			return (i);
+		}
+
+		/**
+		 * @brief Returns the number of elements equal to val.
+		*/
+		template <class T>
+		size_t	count(const T* p, size_t n, T val)
+		{
+			size_t	c = 0;
+			size_t	i = 0;
+
+# ifdef FT_SIMD_X86
+			typedef typename lanes_for<T>::type	L;
+			typename L::type					v;
+			const char*										bytes;
+
+			memcpy(&v, &val, sizeof(T));
+			bytes = reinterpret_cast<const char*>(p);
+			if (has_avx2())
+				c = count_avx2<L>(bytes, n, v, i);
+			else if (has_sse41())
+				c = count_sse41<L>(bytes, n, v, i);
+# endif
+			for (; i < n; i++)
+				c += (p[i] == val);
+			return (c);
+		}
+
+		/**
+		 * @brief Returns the index of the first smallest (Max false) or
+		 * greatest (Max true) element, n being at least 1. The extreme value
+		 * is computed with the min/max instructions, then located with find.
+		 * A NaN first element is never replaced by the scalar loop, so it is
+		 * returned as is.
+		*/
+		template <bool Max, class T>
+		size_t	extreme(const T* p, size_t n)
+		{
+# ifdef FT_SIMD_X86
+			typedef typename lanes_for<T>::type	L;
+			typename L::type					u;
+			size_t											i;
+
+			if (!(p[0] == p[0]))
+				return (0);
+			memcpy(&u, p, sizeof(T));
+			if (minmax_dispatch<L, Max>(reinterpret_cast<const char*>(p), n, u,
+				i, bool_constant<L::has_minmax>()))
+			{
+				T	val;
+				memcpy(&val, &u, sizeof(T));
+				for (; i < n; i++)
+					val = ((Max ? val < p[i] : p[i] < val) ? p[i] : val);
+				return (find(p, n, val));
+			}
+# endif
+			size_t	best = 0;
+
+			for (size_t j = 1; j < n; j++)
+				if (Max ? p[best] < p[j] : p[j] < p[best])
+					best = j;
+			return (best);
+		}
+	}
+}
+
+#endif /* ********************************************************** SIMD_HPP */
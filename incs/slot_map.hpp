@@ -0,0 +1,326 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   slot_map.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/27 16:40:21 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/27 16:40:21 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SLOT_MAP_HPP
+# define SLOT_MAP_HPP
+
+# include <stdexcept>
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Container of values addressed by generational keys. The values
+	 * are kept packed in a vector, so iterating over them is a plain vector
+	 * scan. A key names a slot and the generation the slot had when the
+	 * value was inserted; the slot records where its value currently sits
+	 * in the vector. Erasing moves the last value into the hole and bumps
+	 * the slot's generation, so keys to erased values are detected as stale
+	 * even once their slot is reused from the free list. Insertion, erasure
+	 * and lookup are O(1); erasing changes the order of the values and
+	 * invalidates iterators, but never keys.
+	 * @tparam T Type of the values.
+	*/
+	template <class T>
+	class slot_map
+	{
+		public:
+
+			typedef T										value_type;
+			typedef size_t									size_type;
+			typedef typename ft::vector<T>::iterator		iterator;
+			typedef typename ft::vector<T>::const_iterator	const_iterator;
+
+			/**
+			 * @brief Generational key of a value.
+			*/
+			struct key_type
+			{
+				size_type	index;
+				size_type	generation;
+
+				bool operator==(const key_type& k) const
+				{
+					return (index == k.index && generation == k.generation);
+				}
+				bool operator!=(const key_type& k) const
+				{
+					return (!(*this == k));
+				}
+			};
+
+		private:
+
+			static const size_type	npos = static_cast<size_type>(-1);
+
+			/**
+			 * @brief While its value is live, index is the value's position
+			 * in the vector of values; otherwise, it is the next free slot.
+			*/
+			struct Slot
+			{
+				size_type	index;
+				size_type	generation;
+
+				Slot(size_type i, size_type g) : index(i), generation(g) {}
+			};
+
+			ft::vector<T>			_values;
+			ft::vector<size_type>	_owners;
+			ft::vector<Slot>		_slots;
+			size_type				_free;
+
+		public:
+
+			slot_map() : _free(npos) {}
+
+			slot_map(const slot_map& x)
+			: _values(x._values), _owners(x._owners), _slots(x._slots),
+			_free(x._free) {}
+
+			~slot_map() {}
+
+			slot_map& operator=(const slot_map& x)
+			{
+				slot_map	tmp(x);
+
+				this->swap(tmp);
+				return (*this);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (_values.begin()); }
+			const_iterator begin() const { return (_values.begin()); }
+			iterator end() { return (_values.end()); }
+			const_iterator end() const { return (_values.end()); }
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_values.empty()); }
+			size_type size() const { return (_values.size()); }
+
+			/**
+			 * @brief Reserves room for n values, so that inserting up to n
+			 * values does not reallocate.
+			*/
+			void reserve(size_type n)
+			{
+				_values.reserve(n);
+				_owners.reserve(n);
+				_slots.reserve(n);
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			/**
+			 * @brief Returns the value of k, which must be valid.
+			*/
+			value_type& operator[](const key_type& k)
+			{
+				return (_values[_slots[k.index].index]);
+			}
+			const value_type& operator[](const key_type& k) const
+			{
+				return (_values[_slots[k.index].index]);
+			}
+
+			/**
+			 * @brief Returns the value of k.
+			 * @throw std::out_of_range if k is stale.
+			*/
+			value_type& at(const key_type& k)
+			{
+				if (!this->contains(k))
+					throw std::out_of_range("slot_map::at");
+				return ((*this)[k]);
+			}
+			const value_type& at(const key_type& k) const
+			{
+				if (!this->contains(k))
+					throw std::out_of_range("slot_map::at");
+				return ((*this)[k]);
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Appends a copy of val, in a free slot if there is one.
+			 * @return The key of the new value.
+			*/
+			key_type insert(const value_type& val)
+			{
+				key_type	k;
+
+				_values.push_back(val);
+				try
+				{
+					if (_free == npos)
+					{
+						_slots.push_back(Slot(npos, 0));
+						_free = _slots.size() - 1;
+					}
+					_owners.push_back(_free);
+				}
+				catch (...)
+				{
+					_values.pop_back();
+					throw;
+				}
+				k.index = _free;
+				k.generation = _slots[_free].generation;
+				_free = _slots[k.index].index;
+				_slots[k.index].index = _values.size() - 1;
+				return (k);
+			}
+
+			/**
+			 * @brief Removes the value of k, if k is valid, moving the last
+			 * value into its place. Its slot goes to the free list.
+			 * @return The number of values removed.
+			*/
+			size_type erase(const key_type& k)
+			{
+				if (!this->contains(k))
+					return (0);
+				size_type	pos = _slots[k.index].index;
+				size_type	last = _values.size() - 1;
+
+				if (pos != last)
+				{
+					_values[pos] = _values[last];
+					_owners[pos] = _owners[last];
+					_slots[_owners[pos]].index = pos;
+				}
+				_values.pop_back();
+				_owners.pop_back();
+				this->release(k.index);
+				return (1);
+			}
+
+			/**
+			 * @brief Removes the value at position.
+			 * @return An iterator to the value moved into its place, or end().
+			*/
+			iterator erase(iterator position)
+			{
+				size_type	pos = position - _values.begin();
+
+				this->erase(this->key_of(pos));
+				return (_values.begin() + pos);
+			}
+
+			/**
+			 * @brief Removes every value. Every key becomes stale.
+			*/
+			void clear()
+			{
+				for (size_type i = 0; i < _owners.size(); i++)
+					this->release(_owners[i]);
+				_values.clear();
+				_owners.clear();
+			}
+
+			void swap(slot_map& x)
+			{
+				size_type	tmp = _free;
+
+				_values.swap(x._values);
+				_owners.swap(x._owners);
+				_slots.swap(x._slots);
+				_free = x._free;
+				x._free = tmp;
+			}
+
+/*
+** -------------------------------- OPERATIONS ---------------------------------
+*/
+
+			/**
+			 * @brief Tells whether k refers to a value of the slot map.
+			*/
+			bool contains(const key_type& k) const
+			{
+				return (k.index < _slots.size()
+					&& _slots[k.index].generation == k.generation);
+			}
+
+			/**
+			 * @brief Returns an iterator to the value of k, or end() if k is
+			 * stale.
+			*/
+			iterator find(const key_type& k)
+			{
+				if (!this->contains(k))
+					return (_values.end());
+				return (_values.begin() + _slots[k.index].index);
+			}
+			const_iterator find(const key_type& k) const
+			{
+				if (!this->contains(k))
+					return (_values.end());
+				return (_values.begin() + _slots[k.index].index);
+			}
+
+			/**
+			 * @brief Returns the key of the value at position.
+			*/
+			key_type key_of(const_iterator position) const
+			{
+				return (this->key_of(position - _values.begin()));
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			key_type key_of(size_type pos) const
+			{
+				key_type	k;
+
+				k.index = _owners[pos];
+				k.generation = _slots[k.index].generation;
+				return (k);
+			}
+
+			/**
+			 * @brief Puts slot s on the free list with a new generation.
+			*/
+			void release(size_type s)
+			{
+				_slots[s].generation++;
+				_slots[s].index = _free;
+				_free = s;
+			}
+	};
+
+	template <class T>
+	const typename slot_map<T>::size_type	slot_map<T>::npos;
+
+	template <class T>
+	void swap(slot_map<T>& x, slot_map<T>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ****************************************************** SLOT_MAP_HPP */
@@ -0,0 +1,519 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   small_vector.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/16 13:27:51 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/16 13:27:51 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SMALL_VECTOR_HPP
+# define SMALL_VECTOR_HPP
+
+# include <memory>
+# include <limits>
+# include <stdexcept>
+# include "utils.hpp"
+# include "growth_policy.hpp"
+# include "vector_iterators.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Small vectors are sequence containers with the interface of
+	 * ft::vector, which keep up to N elements inside the object itself and
+	 * only allocate storage from the heap once they grow beyond that. Short
+	 * lived vectors that stay small never touch the allocator.
+	 * @tparam T Type of the elements.
+	 * @tparam N Number of elements stored inline, at least 1.
+	 * @tparam Alloc Type of the allocator object used once the elements no
+	 * longer fit inline.
+	 * @tparam Growth Growth policy deciding the new capacity when the
+	 * elements no longer fit (see growth_policy.hpp). By default, the
+	 * capacity is doubled.
+	*/
+	template <class T, size_t N, class Alloc = std::allocator<T>,
+		class Growth = growth_double>
+	class small_vector
+	{
+		public:
+
+			typedef T											value_type;
+			typedef Alloc										allocator_type;
+			typedef Growth										growth_policy;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef Vector_iterator<T>							iterator;
+			typedef Vector_const_iterator<T>					const_iterator;
+			typedef Vector_const_reverse_iterator<T>			const_reverse_iterator;
+			typedef Vector_reverse_iterator<T>					reverse_iterator;
+			typedef ptrdiff_t									difference_type;
+			typedef size_t										size_type;
+
+			static const size_type	inline_capacity = N;
+
+		private:
+
+			size_type		_size;
+			size_type		_capacity;
+			allocator_type	_alloc;
+			pointer			_head;
+			char			_inline[sizeof(T) * N]
+				__attribute__((aligned(__alignof__(T))));
+
+		public:
+
+			/**
+			 * @brief empty container constructor (default constructor):
+			 * Constructs an empty container using its inline storage.
+			 * @param alloc Allocator object.
+			*/
+			explicit small_vector(const allocator_type& alloc = allocator_type())
+			: _size(0), _capacity(N), _alloc(alloc), _head(inline_head()) {}
+
+			/**
+			 * @brief fill constructor: Constructs a container with n copies of
+			 * val.
+			 * @param n Initial container size.
+			 * @param val Value to fill the container with.
+			 * @param alloc Allocator object.
+			*/
+			explicit small_vector(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())
+			: _size(0), _capacity(N), _alloc(alloc), _head(inline_head())
+			{
+				this->assign(n, val);
+			}
+
+			/**
+			 * @brief range constructor: Constructs a container with a copy of
+			 * each element of the range [first,last), in the same order.
+			 * @param first,last Input iterators to the initial and final
+			 * positions in a range.
+			 * @param alloc Allocator object.
+			*/
+			template <class InputIterator>
+			small_vector(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last,
+				const allocator_type& alloc = allocator_type())
+			: _size(0), _capacity(N), _alloc(alloc), _head(inline_head())
+			{
+				this->assign(first, last);
+			}
+
+			/**
+			 * @brief copy constructor: Constructs a container with a copy of
+			 * each of the elements in x, in the same order. The copy only
+			 * allocates if x does not fit inline.
+			*/
+			small_vector(const small_vector& x)
+			: _size(0), _capacity(N), _alloc(x._alloc), _head(inline_head())
+			{
+				this->assign(x.begin(), x.end());
+			}
+
+			/**
+			 * @brief Destroys the elements and releases heap storage, if any.
+			*/
+			~small_vector()
+			{
+				this->clear();
+				if (!this->is_inline())
+					_alloc.deallocate(_head, _capacity);
+			}
+
+			small_vector& operator=(const small_vector& x)
+			{
+				if (this != &x)
+					this->assign(x.begin(), x.end());
+				return (*this);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(_head)); }
+			const_iterator begin() const { return (const_iterator(_head)); }
+			iterator end() { return (iterator(_head + _size)); }
+			const_iterator end() const { return (const_iterator(_head + _size)); }
+
+			reverse_iterator rbegin()
+			{
+				return (reverse_iterator(this->end()));
+			}
+
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(iterator(_head + _size)));
+			}
+
+			reverse_iterator rend()
+			{
+				return (reverse_iterator(this->begin()));
+			}
+
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(iterator(_head)));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			size_type size() const { return (_size); }
+			size_type max_size() const { return (_alloc.max_size()); }
+			size_type capacity() const { return (_capacity); }
+			bool empty() const { return (_size == 0); }
+
+			/**
+			 * @brief Returns whether the elements are stored inside the object
+			 * (true) or on the heap (false).
+			*/
+			bool is_inline() const
+			{
+				return (_head == inline_head());
+			}
+
+			/**
+			 * @brief Resizes the container so that it contains n elements,
+			 * destroying the ones beyond n or appending copies of val. When
+			 * n does not fit, the capacity grows as for push_back, so growing
+			 * one element at a time stays amortized.
+			*/
+			void resize(size_type n, value_type val = value_type())
+			{
+				if (n > _capacity)
+					this->reallocate(this->grow(n));
+				while (n > _size)
+					_alloc.construct(&_head[_size++], val);
+				while (n < _size)
+					_alloc.destroy(&_head[--_size]);
+			}
+
+			/**
+			 * @brief Requests that the capacity be at least enough to contain
+			 * n elements, moving them to the heap if needed.
+			 * @throw std::length_error if n is greater than max_size.
+			*/
+			void reserve(size_type n)
+			{
+				if (n > this->max_size())
+					throw std::length_error("resized above max_size");
+				if (n > _capacity)
+					this->reallocate(n);
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type n) { return (_head[n]); }
+			const_reference operator[](size_type n) const { return (_head[n]); }
+
+			reference at(size_type n)
+			{
+				if (n >= _size)
+					throw std::out_of_range("out-of-range");
+				return (_head[n]);
+			}
+
+			const_reference at(size_type n) const
+			{
+				if (n >= _size)
+					throw std::out_of_range("out-of-range");
+				return (_head[n]);
+			}
+
+			reference front() { return (_head[0]); }
+			const_reference front() const { return (_head[0]); }
+			reference back() { return (_head[_size - 1]); }
+			const_reference back() const { return (_head[_size - 1]); }
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Replaces the contents with copies of the elements in the
+			 * range [first,last).
+			*/
+			template <class InputIterator>
+			void assign(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last)
+			{
+				this->clear();
+				this->insert(this->end(), first, last);
+			}
+
+			/**
+			 * @brief Replaces the contents with n copies of val.
+			*/
+			void assign(size_type n, const value_type& val)
+			{
+				this->clear();
+				this->insert(this->end(), n, val);
+			}
+
+			void push_back(const value_type& val)
+			{
+				if (_size == _capacity)
+				{
+					value_type	copy(val);
+					this->reallocate(this->grow(_size + 1));
+					_alloc.construct(&_head[_size++], copy);
+				}
+				else
+					_alloc.construct(&_head[_size++], val);
+			}
+
+			void pop_back()
+			{
+				_alloc.destroy(&_head[--_size]);
+			}
+
+			/**
+			 * @brief Inserts a copy of val before position.
+			 * @return An iterator to the inserted element.
+			*/
+			iterator insert(iterator position, const value_type& val)
+			{
+				difference_type	offset = position - this->begin();
+
+				this->insert(position, 1, val);
+				return (this->begin() + offset);
+			}
+
+			/**
+			 * @brief Inserts n copies of val before position.
+			*/
+			void insert(iterator position, size_type n, const value_type& val)
+			{
+				if (n == 0)
+					return ;
+				size_type	offset = position - this->begin();
+				value_type	copy(val);
+
+				this->open_gap(offset, n);
+				for (size_type i = offset; i < offset + n; i++)
+					this->put(i, copy);
+				_size += n;
+			}
+
+			/**
+			 * @brief Inserts copies of the elements in the range [first,last)
+			 * before position. The range shall not refer to this container.
+			*/
+			template <class InputIterator>
+			void insert(iterator position, typename ft::enable_if
+				<!std::numeric_limits<InputIterator>::is_integer, InputIterator>
+				::type first, InputIterator last)
+			{
+				size_type		offset = position - this->begin();
+				size_type		n = 0;
+				InputIterator	tmp(first);
+
+				while (tmp != last)
+				{
+					++tmp;
+					++n;
+				}
+				if (n == 0)
+					return ;
+				this->open_gap(offset, n);
+				for (size_type i = offset; first != last; ++first, ++i)
+					this->put(i, *first);
+				_size += n;
+			}
+
+			iterator erase(iterator position)
+			{
+				return (this->erase(position, position + 1));
+			}
+
+			/**
+			 * @brief Removes the elements in [first,last).
+			 * @return An iterator to the element that followed the last erased
+			 * one.
+			*/
+			iterator erase(iterator first, iterator last)
+			{
+				size_type	offset = first - this->begin();
+				size_type	n = last - first;
+
+				for (size_type i = offset; i + n < _size; i++)
+					_head[i] = _head[i + n];
+				for (size_type i = 0; i < n; i++)
+					_alloc.destroy(&_head[--_size]);
+				return (this->begin() + offset);
+			}
+
+			/**
+			 * @brief Exchanges the contents with x. When both containers are on
+			 * the heap only the pointers are exchanged, otherwise the elements
+			 * are copied, so iterators to inline elements are invalidated.
+			*/
+			void swap(small_vector& x)
+			{
+				if (this == &x)
+					return ;
+				if (!this->is_inline() && !x.is_inline())
+				{
+					swap(_size, x._size);
+					swap(_capacity, x._capacity);
+					swap(_alloc, x._alloc);
+					swap(_head, x._head);
+					return ;
+				}
+				small_vector	tmp(x);
+				x = *this;
+				*this = tmp;
+			}
+
+			void clear()
+			{
+				while (_size)
+					_alloc.destroy(&_head[--_size]);
+			}
+
+			allocator_type get_allocator() const { return (_alloc); }
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			pointer	inline_head() const
+			{
+				return (reinterpret_cast<pointer>(const_cast<char*>(_inline)));
+			}
+
+			/**
+			 * @brief Computes the capacity to reallocate to when new_size
+			 * elements no longer fit, as decided by the growth policy.
+			 * @throw std::length_error if new_size is greater than max_size.
+			*/
+			size_type grow(size_type new_size) const
+			{
+				if (new_size > this->max_size())
+					throw std::length_error("resized above max_size");
+				size_type	new_capacity = growth_policy::next_capacity(_capacity,
+					new_size, sizeof(value_type));
+				if (new_capacity < new_size || new_capacity > this->max_size())
+					new_capacity = this->max_size();
+				return (new_capacity);
+			}
+
+			/**
+			 * @brief Moves the elements to a heap buffer of new_capacity
+			 * elements.
+			*/
+			void reallocate(size_type new_capacity)
+			{
+				pointer	new_head = _alloc.allocate(new_capacity);
+
+				for (size_type i = 0; i < _size; i++)
+				{
+					_alloc.construct(&new_head[i], _head[i]);
+					_alloc.destroy(&_head[i]);
+				}
+				if (!this->is_inline())
+					_alloc.deallocate(_head, _capacity);
+				_head = new_head;
+				_capacity = new_capacity;
+			}
+
+			/**
+			 * @brief Makes room for n elements at offset, shifting the
+			 * following ones towards the end. Slots of the gap below _size
+			 * still hold constructed elements, the ones above are raw.
+			*/
+			void open_gap(size_type offset, size_type n)
+			{
+				if (_size + n > _capacity)
+					this->reallocate(this->grow(_size + n));
+				for (size_type i = _size; i > offset; i--)
+				{
+					if (i - 1 + n >= _size)
+						_alloc.construct(&_head[i - 1 + n], _head[i - 1]);
+					else
+						_head[i - 1 + n] = _head[i - 1];
+				}
+			}
+
+			void put(size_type i, const value_type& val)
+			{
+				if (i < _size)
+					_head[i] = val;
+				else
+					_alloc.construct(&_head[i], val);
+			}
+
+			template<class U>
+			void swap(U& u1, U& u2)
+			{
+				U tmp = u2;
+				u2 = u1;
+				u1 = tmp;
+			}
+	};
+
+/*
+** -------------------------------- OVERLOADS ----------------------------------
+*/
+
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator==(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			if (lhs.size() != rhs.size())
+				return (false);
+			return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+		}
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator!=(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator<(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+				rhs.begin(), rhs.end()));
+		}
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator<=(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator>(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			return (rhs < lhs);
+		}
+		template <class T, size_t N, class Alloc, class Growth>
+		bool operator>=(const small_vector<T,N,Alloc,Growth>& lhs,
+			const small_vector<T,N,Alloc,Growth>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+		template <class T, size_t N, class Alloc, class Growth>
+		void swap(small_vector<T,N,Alloc,Growth>& x, small_vector<T,N,Alloc,Growth>& y)
+		{
+			x.swap(y);
+		}
+}
+
+#endif /* ************************************************** SMALL_VECTOR_HPP */
@@ -0,0 +1,804 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   soa_vector.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/28 15:26:09 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/28 15:26:09 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SOA_VECTOR_HPP
+# define SOA_VECTOR_HPP
+
+# include <stddef.h>
+# include <iterator>
+# include <limits>
+# include <stdexcept>
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Placeholder for the unused fields of soa_row and soa_vector.
+	*/
+	struct soa_none {};
+
+	/**
+	 * @brief Record of up to six fields, built as a list of head fields and
+	 * tail records. It is the value_type of soa_vector; field I is reached
+	 * with ft::get<I>.
+	*/
+	template <class T0, class T1 = soa_none, class T2 = soa_none,
+		class T3 = soa_none, class T4 = soa_none, class T5 = soa_none>
+	struct soa_row
+	{
+		typedef T0									head_type;
+		typedef soa_row<T1, T2, T3, T4, T5>			tail_type;
+
+		head_type	head;
+		tail_type	tail;
+
+		soa_row(const T0& a0 = T0(), const T1& a1 = T1(), const T2& a2 = T2(),
+			const T3& a3 = T3(), const T4& a4 = T4(), const T5& a5 = T5())
+		: head(a0), tail(a1, a2, a3, a4, a5) {}
+	};
+
+	template <>
+	struct soa_row<soa_none, soa_none, soa_none, soa_none, soa_none, soa_none>
+	{
+		soa_row(const soa_none& = soa_none(), const soa_none& = soa_none(),
+			const soa_none& = soa_none(), const soa_none& = soa_none(),
+			const soa_none& = soa_none(), const soa_none& = soa_none()) {}
+	};
+
+	/**
+	 * @brief Type of the head member at depth I of a list of heads and tails.
+	*/
+	template <size_t I, class Cons>
+	struct Soa_type
+	{
+		typedef typename Soa_type<I - 1, typename Cons::tail_type>::type	type;
+	};
+
+	template <class Cons>
+	struct Soa_type<0, Cons>
+	{
+		typedef typename Cons::head_type	type;
+	};
+
+	/**
+	 * @brief Returns the head member at depth I of a list of heads and
+	 * tails.
+	*/
+	template <size_t I>
+	struct Soa_at
+	{
+		template <class Cons>
+		static typename Soa_type<I, Cons>::type& get(Cons& c)
+		{
+			return (Soa_at<I - 1>::get(c.tail));
+		}
+		template <class Cons>
+		static const typename Soa_type<I, Cons>::type& get(const Cons& c)
+		{
+			return (Soa_at<I - 1>::get(c.tail));
+		}
+	};
+
+	template <>
+	struct Soa_at<0>
+	{
+		template <class Cons>
+		static typename Cons::head_type& get(Cons& c)
+		{
+			return (c.head);
+		}
+		template <class Cons>
+		static const typename Cons::head_type& get(const Cons& c)
+		{
+			return (c.head);
+		}
+	};
+
+	/**
+	 * @brief One ft::vector per field of soa_row<T0, ..., T5>. Every
+	 * operation is applied to the head column, then to the tail columns; if
+	 * the tail throws, the head is restored so that the columns keep the same
+	 * size.
+	*/
+	template <class T0, class T1 = soa_none, class T2 = soa_none,
+		class T3 = soa_none, class T4 = soa_none, class T5 = soa_none>
+	struct Soa_columns
+	{
+		typedef ft::vector<T0>							head_type;
+		typedef Soa_columns<T1, T2, T3, T4, T5>			tail_type;
+		typedef soa_row<T0, T1, T2, T3, T4, T5>			row_type;
+		typedef size_t									size_type;
+
+		head_type	head;
+		tail_type	tail;
+
+		void gather(size_type i, row_type& r) const
+		{
+			r.head = head[i];
+			tail.gather(i, r.tail);
+		}
+
+		void scatter(size_type i, const row_type& r)
+		{
+			head[i] = r.head;
+			tail.scatter(i, r.tail);
+		}
+
+		void push_back(const row_type& r)
+		{
+			head.push_back(r.head);
+			try
+			{
+				tail.push_back(r.tail);
+			}
+			catch (...)
+			{
+				head.pop_back();
+				throw;
+			}
+		}
+
+		void pop_back()
+		{
+			head.pop_back();
+			tail.pop_back();
+		}
+
+		void insert(size_type pos, size_type n, const row_type& r)
+		{
+			head.insert(head.begin() + pos, n, r.head);
+			try
+			{
+				tail.insert(pos, n, r.tail);
+			}
+			catch (...)
+			{
+				head.erase(head.begin() + pos, head.begin() + pos + n);
+				throw;
+			}
+		}
+
+		/**
+		 * @brief Inserts the rows of x before pos, shifting each column
+		 * once.
+		*/
+		void insert(size_type pos, const Soa_columns& x)
+		{
+			head.insert(head.begin() + pos, x.head.begin(), x.head.end());
+			try
+			{
+				tail.insert(pos, x.tail);
+			}
+			catch (...)
+			{
+				head.erase(head.begin() + pos, head.begin() + pos + x.head.size());
+				throw;
+			}
+		}
+
+		void erase(size_type pos, size_type n)
+		{
+			head.erase(head.begin() + pos, head.begin() + pos + n);
+			tail.erase(pos, n);
+		}
+
+		void resize(size_type n, const row_type& r)
+		{
+			size_type	old = head.size();
+
+			head.resize(n, r.head);
+			try
+			{
+				tail.resize(n, r.tail);
+			}
+			catch (...)
+			{
+				head.resize(old);
+				throw;
+			}
+		}
+
+		void reserve(size_type n)
+		{
+			head.reserve(n);
+			tail.reserve(n);
+		}
+
+		void clear()
+		{
+			head.clear();
+			tail.clear();
+		}
+
+		void swap(Soa_columns& x)
+		{
+			head.swap(x.head);
+			tail.swap(x.tail);
+		}
+	};
+
+	template <>
+	struct Soa_columns<soa_none, soa_none, soa_none, soa_none, soa_none, soa_none>
+	{
+		typedef soa_row<soa_none>	row_type;
+		typedef size_t				size_type;
+
+		void gather(size_type, row_type&) const {}
+		void scatter(size_type, const row_type&) {}
+		void push_back(const row_type&) {}
+		void pop_back() {}
+		void insert(size_type, size_type, const row_type&) {}
+		void insert(size_type, const Soa_columns&) {}
+		void erase(size_type, size_type) {}
+		void resize(size_type, const row_type&) {}
+		void reserve(size_type) {}
+		void clear() {}
+		void swap(Soa_columns&) {}
+	};
+
+	/**
+	 * @brief Proxy to a row of a soa_vector: it converts to and is assigned
+	 * from the row's value_type, and ft::get<I> reaches a single field in its
+	 * column without touching the others.
+	*/
+	template <class Columns>
+	class Soa_const_reference;
+
+	template <class Columns>
+	class Soa_reference
+	{
+		friend class Soa_const_reference<Columns>;
+
+		public:
+
+			typedef typename Columns::row_type	value_type;
+
+		protected:
+
+			Columns	*m_columns;
+			size_t	m_index;
+
+		public:
+
+			Soa_reference(Columns* columns, size_t index)
+			: m_columns(columns), m_index(index) {}
+
+			operator value_type() const
+			{
+				value_type	r;
+
+				m_columns->gather(m_index, r);
+				return (r);
+			}
+			Soa_reference& operator=(const value_type& r)
+			{
+				m_columns->scatter(m_index, r);
+				return (*this);
+			}
+			Soa_reference& operator=(const Soa_reference& x)
+			{
+				return (*this = static_cast<value_type>(x));
+			}
+
+			template <size_t I>
+			typename Soa_type<I, Columns>::type::reference get() const
+			{
+				return (Soa_at<I>::get(*m_columns)[m_index]);
+			}
+	};
+
+	template <class Columns>
+	class Soa_const_reference
+	{
+		public:
+
+			typedef typename Columns::row_type	value_type;
+
+		protected:
+
+			const Columns	*m_columns;
+			size_t			m_index;
+
+		public:
+
+			Soa_const_reference(const Columns* columns, size_t index)
+			: m_columns(columns), m_index(index) {}
+			Soa_const_reference(const Soa_reference<Columns>& x)
+			: m_columns(x.m_columns), m_index(x.m_index) {}
+
+			operator value_type() const
+			{
+				value_type	r;
+
+				m_columns->gather(m_index, r);
+				return (r);
+			}
+
+			template <size_t I>
+			typename Soa_type<I, Columns>::type::const_reference get() const
+			{
+				return (Soa_at<I>::get(*m_columns)[m_index]);
+			}
+	};
+
+	template <class Columns>
+	class Soa_const_iterator;
+
+	/**
+	 * @brief Random access iterator over the rows of a soa_vector: the
+	 * columns and the index of the row. Dereferencing yields a proxy.
+	*/
+	template <class Columns>
+	class Soa_iterator
+	{
+		public:
+
+			typedef typename Columns::row_type		value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::random_access_iterator_tag	iterator_category;
+			typedef Soa_reference<Columns>			reference;
+			typedef void							pointer;
+
+		protected:
+
+			Columns	*m_columns;
+			size_t	m_index;
+
+		private:
+
+			Soa_iterator(const Soa_const_iterator<Columns>& );
+
+		public:
+
+			Soa_iterator(Columns* columns = NULL, size_t index = 0)
+			: m_columns(columns), m_index(index) {}
+			Soa_iterator(const Soa_iterator& from)
+			: m_columns(from.m_columns), m_index(from.m_index) {}
+			~Soa_iterator() {}
+
+			Columns*	getColumns() const { return m_columns; }
+			size_t		getIndex() const { return m_index; }
+			Soa_iterator& operator=(const Soa_iterator& it)
+			{
+				m_columns = it.m_columns;
+				m_index = it.m_index;
+				return (*this);
+			}
+
+			bool operator==(const Soa_iterator& it) const
+			{
+				return (m_index == it.m_index);
+			}
+			bool operator!=(const Soa_iterator& it) const
+			{
+				return (m_index != it.m_index);
+			}
+			reference operator*() const
+			{
+				return (reference(m_columns, m_index));
+			}
+			reference operator[](difference_type n) const
+			{
+				return (reference(m_columns, m_index + n));
+			}
+			Soa_iterator& operator++()
+			{
+				m_index++;
+				return (*this);
+			}
+			Soa_iterator operator++(int)
+			{
+				Soa_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Soa_iterator& operator--()
+			{
+				m_index--;
+				return (*this);
+			}
+			Soa_iterator operator--(int)
+			{
+				Soa_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+			Soa_iterator operator+(difference_type n) const
+			{
+				return (Soa_iterator(m_columns, m_index + n));
+			}
+			Soa_iterator operator-(difference_type n) const
+			{
+				return (Soa_iterator(m_columns, m_index - n));
+			}
+			difference_type operator-(const Soa_iterator& other) const
+			{
+				return (static_cast<difference_type>(m_index - other.m_index));
+			}
+			friend Soa_iterator operator+(difference_type n,
+				const Soa_iterator& other)
+			{
+				return (other.operator+(n));
+			}
+			Soa_iterator& operator+=(difference_type n)
+			{
+				m_index += n;
+				return (*this);
+			}
+			Soa_iterator& operator-=(difference_type n)
+			{
+				m_index -= n;
+				return (*this);
+			}
+			bool operator<(const Soa_iterator& other) const
+			{
+				return (m_index < other.m_index);
+			}
+			bool operator>(const Soa_iterator& other) const
+			{
+				return (m_index > other.m_index);
+			}
+			bool operator<=(const Soa_iterator& other) const
+			{
+				return (m_index <= other.m_index);
+			}
+			bool operator>=(const Soa_iterator& other) const
+			{
+				return (m_index >= other.m_index);
+			}
+	};
+
+	template <class Columns>
+	class Soa_const_iterator : public Soa_iterator<Columns>
+	{
+		public:
+
+			typedef Soa_const_reference<Columns>	reference;
+			typedef Soa_const_reference<Columns>	const_reference;
+			typedef ptrdiff_t						difference_type;
+
+			Soa_const_iterator(const Columns* columns = NULL, size_t index = 0)
+			: Soa_iterator<Columns>(const_cast<Columns*>(columns), index) {}
+			Soa_const_iterator(const Soa_iterator<Columns>& from)
+			: Soa_iterator<Columns>(from.getColumns(), from.getIndex()) {}
+
+			Soa_const_iterator& operator=(const Soa_const_iterator& it)
+			{
+				Soa_iterator<Columns>::operator=(it);
+				return (*this);
+			}
+			const_reference operator*() const
+			{
+				return (const_reference(this->m_columns, this->m_index));
+			}
+			const_reference operator[](difference_type n) const
+			{
+				return (const_reference(this->m_columns, this->m_index + n));
+			}
+	};
+
+	/**
+	 * @brief Structure of arrays: a sequence of soa_row records whose fields
+	 * are each stored in their own ft::vector. A loop reading one field of
+	 * every row streams a single contiguous column instead of pulling whole
+	 * records through the cache, and data<I>() hands that column to the
+	 * kernels of simd.hpp. Rows are not addressable: the subscript operators
+	 * and iterators yield proxies that convert to and from value_type, and
+	 * ft::get<I> on a proxy accesses field I in place.
+	 * @tparam T0, ..., T5 Types of the fields, up to six. The unused ones are
+	 * soa_none. The fields must be default constructible.
+	*/
+	template <class T0, class T1 = soa_none, class T2 = soa_none,
+		class T3 = soa_none, class T4 = soa_none, class T5 = soa_none>
+	class soa_vector
+	{
+		typedef Soa_columns<T0, T1, T2, T3, T4, T5>	columns_type;
+
+		public:
+
+			typedef soa_row<T0, T1, T2, T3, T4, T5>			value_type;
+			typedef Soa_reference<columns_type>				reference;
+			typedef Soa_const_reference<columns_type>		const_reference;
+			typedef Soa_iterator<columns_type>				iterator;
+			typedef Soa_const_iterator<columns_type>		const_iterator;
+			typedef std::reverse_iterator<iterator>			reverse_iterator;
+			typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+			typedef ptrdiff_t								difference_type;
+			typedef size_t									size_type;
+
+			/**
+			 * @brief Type of field I.
+			*/
+			template <size_t I>
+			struct field
+			{
+				typedef typename Soa_type<I, value_type>::type	type;
+			};
+
+		private:
+
+			columns_type	_columns;
+
+		public:
+
+			soa_vector() {}
+
+			explicit soa_vector(size_type n, const value_type& val = value_type())
+			{
+				_columns.resize(n, val);
+			}
+
+			template <class InputIterator>
+			soa_vector(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					_columns.push_back(*first);
+			}
+
+			soa_vector(const soa_vector& x) : _columns(x._columns) {}
+
+			~soa_vector() {}
+
+			soa_vector& operator=(const soa_vector& x)
+			{
+				_columns = x._columns;
+				return (*this);
+			}
+
+			template <class InputIterator>
+			void assign(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last)
+			{
+				_columns.clear();
+				for (; first != last; ++first)
+					_columns.push_back(*first);
+			}
+
+			void assign(size_type n, const value_type& val)
+			{
+				_columns.clear();
+				_columns.resize(n, val);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(&_columns, 0)); }
+			const_iterator begin() const { return (const_iterator(&_columns, 0)); }
+			iterator end() { return (iterator(&_columns, this->size())); }
+			const_iterator end() const
+			{
+				return (const_iterator(&_columns, this->size()));
+			}
+			reverse_iterator rbegin() { return (reverse_iterator(this->end())); }
+			const_reverse_iterator rbegin() const
+			{
+				return (const_reverse_iterator(this->end()));
+			}
+			reverse_iterator rend() { return (reverse_iterator(this->begin())); }
+			const_reverse_iterator rend() const
+			{
+				return (const_reverse_iterator(this->begin()));
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			size_type size() const { return (_columns.head.size()); }
+			size_type max_size() const { return (_columns.head.max_size()); }
+			size_type capacity() const { return (_columns.head.capacity()); }
+			bool empty() const { return (_columns.head.empty()); }
+
+			void resize(size_type n, const value_type& val = value_type())
+			{
+				_columns.resize(n, val);
+			}
+
+			void reserve(size_type n)
+			{
+				_columns.reserve(n);
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type n) { return (reference(&_columns, n)); }
+			const_reference operator[](size_type n) const
+			{
+				return (const_reference(&_columns, n));
+			}
+
+			reference at(size_type n)
+			{
+				if (n >= this->size())
+					throw std::out_of_range("soa_vector::at");
+				return ((*this)[n]);
+			}
+			const_reference at(size_type n) const
+			{
+				if (n >= this->size())
+					throw std::out_of_range("soa_vector::at");
+				return ((*this)[n]);
+			}
+
+			reference front() { return ((*this)[0]); }
+			const_reference front() const { return ((*this)[0]); }
+			reference back() { return ((*this)[this->size() - 1]); }
+			const_reference back() const { return ((*this)[this->size() - 1]); }
+
+			/**
+			 * @brief Returns the column of field I, size() contiguous values.
+			*/
+			template <size_t I>
+			typename field<I>::type* data()
+			{
+				return (this->empty() ? NULL : &Soa_at<I>::get(_columns)[0]);
+			}
+			template <size_t I>
+			const typename field<I>::type* data() const
+			{
+				return (this->empty() ? NULL : &Soa_at<I>::get(_columns)[0]);
+			}
+
+			/**
+			 * @brief Returns the vector holding the column of field I.
+			*/
+			template <size_t I>
+			const ft::vector<typename field<I>::type>& column() const
+			{
+				return (Soa_at<I>::get(_columns));
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			void push_back(const value_type& val) { _columns.push_back(val); }
+			void pop_back() { _columns.pop_back(); }
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				size_type	pos = position.getIndex();
+
+				_columns.insert(pos, 1, val);
+				return (this->begin() + pos);
+			}
+
+			void insert(iterator position, size_type n, const value_type& val)
+			{
+				_columns.insert(position.getIndex(), n, val);
+			}
+
+			/**
+			 * @brief Inserts the rows of [first,last) before position. They
+			 * are first gathered into columns of their own, so that each
+			 * column of the vector is shifted once, by the whole range.
+			*/
+			template <class InputIterator>
+			void insert(iterator position, typename ft::enable_if<!std::numeric_limits
+				<InputIterator>::is_integer, InputIterator>::type first,
+				InputIterator last)
+			{
+				columns_type	rows;
+
+				for (; first != last; ++first)
+					rows.push_back(*first);
+				_columns.insert(position.getIndex(), rows);
+			}
+
+			iterator erase(iterator position)
+			{
+				size_type	pos = position.getIndex();
+
+				_columns.erase(pos, 1);
+				return (this->begin() + pos);
+			}
+
+			iterator erase(iterator first, iterator last)
+			{
+				size_type	pos = first.getIndex();
+
+				_columns.erase(pos, last - first);
+				return (this->begin() + pos);
+			}
+
+			void swap(soa_vector& x) { _columns.swap(x._columns); }
+			void clear() { _columns.clear(); }
+	};
+
+/*
+** -------------------------------- OVERLOADS ----------------------------------
+*/
+
+	template <size_t I, class T0, class T1, class T2, class T3, class T4,
+		class T5>
+	typename Soa_type<I, soa_row<T0, T1, T2, T3, T4, T5> >::type&
+		get(soa_row<T0, T1, T2, T3, T4, T5>& r)
+	{
+		return (Soa_at<I>::get(r));
+	}
+
+	template <size_t I, class T0, class T1, class T2, class T3, class T4,
+		class T5>
+	const typename Soa_type<I, soa_row<T0, T1, T2, T3, T4, T5> >::type&
+		get(const soa_row<T0, T1, T2, T3, T4, T5>& r)
+	{
+		return (Soa_at<I>::get(r));
+	}
+
+	template <size_t I, class Columns>
+	typename Soa_type<I, Columns>::type::reference
+		get(const Soa_reference<Columns>& r)
+	{
+		return (r.template get<I>());
+	}
+
+	template <size_t I, class Columns>
+	typename Soa_type<I, Columns>::type::const_reference
+		get(const Soa_const_reference<Columns>& r)
+	{
+		return (r.template get<I>());
+	}
+
+	template <class T0, class T1, class T2, class T3, class T4, class T5>
+	bool operator==(const soa_row<T0, T1, T2, T3, T4, T5>& lhs,
+		const soa_row<T0, T1, T2, T3, T4, T5>& rhs)
+	{
+		return (lhs.head == rhs.head && lhs.tail == rhs.tail);
+	}
+
+	inline bool operator==(const soa_row<soa_none>&, const soa_row<soa_none>&)
+	{
+		return (true);
+	}
+
+	template <class T0, class T1, class T2, class T3, class T4, class T5>
+	bool operator!=(const soa_row<T0, T1, T2, T3, T4, T5>& lhs,
+		const soa_row<T0, T1, T2, T3, T4, T5>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T0, class T1, class T2, class T3, class T4, class T5>
+	bool operator==(const soa_vector<T0, T1, T2, T3, T4, T5>& lhs,
+		const soa_vector<T0, T1, T2, T3, T4, T5>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		for (size_t i = 0; i < lhs.size(); i++)
+			if (!(static_cast<soa_row<T0, T1, T2, T3, T4, T5> >(lhs[i])
+				== static_cast<soa_row<T0, T1, T2, T3, T4, T5> >(rhs[i])))
+				return (false);
+		return (true);
+	}
+
+	template <class T0, class T1, class T2, class T3, class T4, class T5>
+	bool operator!=(const soa_vector<T0, T1, T2, T3, T4, T5>& lhs,
+		const soa_vector<T0, T1, T2, T3, T4, T5>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T0, class T1, class T2, class T3, class T4, class T5>
+	void swap(soa_vector<T0, T1, T2, T3, T4, T5>& x,
+		soa_vector<T0, T1, T2, T3, T4, T5>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* **************************************************** SOA_VECTOR_HPP */
@@ -0,0 +1,293 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spsc_queue.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/14 09:12:37 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/14 09:12:37 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SPSC_QUEUE_HPP
+# define SPSC_QUEUE_HPP
+
+# include <memory>
+# include "atomic.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Single-producer/single-consumer queues are fixed-capacity ring
+	 * buffers passing elements between exactly two threads without locks and
+	 * without allocating. One thread may only push, the other may only pop.
+	 * The producer and consumer indices live on separate cache lines, and
+	 * each side caches the last index it read from the other one so that it
+	 * only touches the shared line when the queue looks full (or empty).
+	 * @tparam T Type of the elements.
+	 * @tparam Alloc Type of the allocator object used to allocate the ring.
+	*/
+	template <class T, class Alloc = std::allocator<T> >
+	class spsc_queue
+	{
+		public:
+
+			typedef T									value_type;
+			typedef Alloc								allocator_type;
+			typedef typename allocator_type::reference	reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer	pointer;
+			typedef size_t								size_type;
+
+		private:
+
+			/* Read-only once constructed, shared by both threads. */
+			size_type				_mask;
+			pointer					_buffer;
+			allocator_type			_alloc;
+			char					_pad0[FT_CACHELINE_SIZE];
+			/* Owned by the consumer. */
+			ft::atomic<size_type>	_head;
+			size_type				_tail_cache;
+			char					_pad1[FT_CACHELINE_SIZE];
+			/* Owned by the producer. */
+			ft::atomic<size_type>	_tail;
+			size_type				_head_cache;
+			char					_pad2[FT_CACHELINE_SIZE];
+
+			spsc_queue(const spsc_queue&);
+			spsc_queue& operator=(const spsc_queue&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty queue.
+			 * @param capacity Minimum number of elements the queue can hold,
+			 * rounded up to a power of two.
+			 * @param alloc Allocator object.
+			*/
+			explicit spsc_queue(size_type capacity,
+				const allocator_type& alloc = allocator_type())
+			: _mask(1), _buffer(NULL), _alloc(alloc), _head(0), _tail_cache(0),
+				_tail(0), _head_cache(0)
+			{
+				while (_mask < capacity)
+					_mask <<= 1;
+				_buffer = _alloc.allocate(_mask);
+				_mask--;
+			}
+
+			/**
+			 * @brief Destroys the remaining elements and releases the ring.
+			 * No thread may use the queue anymore.
+			*/
+			~spsc_queue()
+			{
+				size_type	tail = _tail.load(memory_order_acquire);
+
+				for (size_type i = _head.load(memory_order_relaxed); i != tail; i++)
+					_alloc.destroy(&_buffer[i & _mask]);
+				_alloc.deallocate(_buffer, _mask + 1);
+			}
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			/**
+			 * @brief Returns whether the queue is empty. From any other thread
+			 * than the consumer the answer may be outdated on return.
+			*/
+			bool empty() const
+			{
+				return (_head.load(memory_order_acquire)
+					== _tail.load(memory_order_acquire));
+			}
+
+			/**
+			 * @brief Returns the number of elements in the queue. From any
+			 * other thread than the consumer or the producer the answer may be
+			 * outdated on return.
+			*/
+			size_type size() const
+			{
+				size_type	head = _head.load(memory_order_acquire);
+
+				return (_tail.load(memory_order_acquire) - head);
+			}
+
+			size_type capacity() const
+			{
+				return (_mask + 1);
+			}
+
+/*
+** --------------------------------- PRODUCER ----------------------------------
+*/
+
+			/**
+			 * @brief Inserts a copy of val at the end of the queue, if there
+			 * is room for it.
+			 * @return true if the element was inserted, false if the queue was
+			 * full.
+			*/
+			bool try_push(const value_type& val)
+			{
+				size_type	tail = _tail.load(memory_order_relaxed);
+
+				if (tail - _head_cache > _mask)
+				{
+					_head_cache = _head.load(memory_order_acquire);
+					if (tail - _head_cache > _mask)
+						return (false);
+				}
+				_alloc.construct(&_buffer[tail & _mask], val);
+				_tail.store(tail + 1, memory_order_release);
+				return (true);
+			}
+
+			/**
+			 * @brief Inserts a copy of val at the end of the queue, waiting
+			 * for the consumer to make room if the queue is full.
+			*/
+			void push(const value_type& val)
+			{
+				unsigned	spins = 0;
+
+				while (!this->try_push(val))
+					cpu_relax(spins);
+			}
+
+			/**
+			 * @brief Inserts as many elements of [first,last) as there is room
+			 * for, and makes them visible to the consumer at once.
+			 * @param first,last Input iterators to the elements to push.
+			 * @return The number of elements inserted, the caller has to retry
+			 * with the remaining ones.
+			 * @throw If copying an element throws, the elements of the batch
+			 * already copied are destroyed and none of them is published.
+			*/
+			template <class InputIterator>
+			size_type push_batch(InputIterator first, InputIterator last)
+			{
+				size_type	tail = _tail.load(memory_order_relaxed);
+				size_type	n = 0;
+
+				if (first == last)
+					return (0);
+				if (tail - _head_cache > _mask)
+					_head_cache = _head.load(memory_order_acquire);
+				size_type	room = _mask + 1 - (tail - _head_cache);
+				try
+				{
+					for (; first != last && n < room; ++first, ++n)
+						_alloc.construct(&_buffer[(tail + n) & _mask], *first);
+				}
+				catch (...)
+				{
+					while (n > 0)
+						_alloc.destroy(&_buffer[(tail + --n) & _mask]);
+					throw;
+				}
+				if (n)
+					_tail.store(tail + n, memory_order_release);
+				return (n);
+			}
+
+/*
+** --------------------------------- CONSUMER ----------------------------------
+*/
+
+			/**
+			 * @brief Returns a reference to the oldest element of the queue.
+			 * Calling this function on an empty queue causes undefined
+			 * behavior.
+			*/
+			reference front()
+			{
+				size_type	head = _head.load(memory_order_relaxed);
+
+				if (head == _tail_cache)
+					_tail_cache = _tail.load(memory_order_acquire);
+				return (_buffer[head & _mask]);
+			}
+
+			/**
+			 * @brief Removes the oldest element of the queue. Calling this
+			 * function on an empty queue causes undefined behavior.
+			*/
+			void pop()
+			{
+				size_type	head = _head.load(memory_order_relaxed);
+
+				_alloc.destroy(&_buffer[head & _mask]);
+				_head.store(head + 1, memory_order_release);
+			}
+
+			/**
+			 * @brief Moves the oldest element of the queue into out, if any.
+			 * @return true if an element was popped, false if the queue was
+			 * empty.
+			*/
+			bool try_pop(value_type& out)
+			{
+				size_type	head = _head.load(memory_order_relaxed);
+
+				if (head == _tail_cache)
+				{
+					_tail_cache = _tail.load(memory_order_acquire);
+					if (head == _tail_cache)
+						return (false);
+				}
+				out = _buffer[head & _mask];
+				_alloc.destroy(&_buffer[head & _mask]);
+				_head.store(head + 1, memory_order_release);
+				return (true);
+			}
+
+			/**
+			 * @brief Pops up to max elements into out, and hands their slots
+			 * back to the producer at once.
+			 * @param out Output iterator receiving the elements, oldest first.
+			 * @param max Maximum number of elements to pop.
+			 * @return The number of elements popped.
+			 * @throw If writing an element to out throws, the elements
+			 * already written are popped and the failing one stays at the
+			 * front of the queue.
+			*/
+			template <class OutputIterator>
+			size_type pop_batch(OutputIterator out, size_type max)
+			{
+				size_type	head = _head.load(memory_order_relaxed);
+				size_type	n = 0;
+
+				if (_tail_cache - head < max)
+					_tail_cache = _tail.load(memory_order_acquire);
+				try
+				{
+					for (; n < max && head + n != _tail_cache; ++n, ++out)
+					{
+						*out = _buffer[(head + n) & _mask];
+						_alloc.destroy(&_buffer[(head + n) & _mask]);
+					}
+				}
+				catch (...)
+				{
+					if (n)
+						_head.store(head + n, memory_order_release);
+					throw;
+				}
+				if (n)
+					_head.store(head + n, memory_order_release);
+				return (n);
+			}
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+	};
+}
+
+#endif /* **************************************************** SPSC_QUEUE_HPP */
@@ -0,0 +1,588 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stable_vector.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/27 10:18:33 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/27 10:18:33 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef STABLE_VECTOR_HPP
+# define STABLE_VECTOR_HPP
+
+# include <stddef.h>
+# include <algorithm>
+# include <iterator>
+# include <limits>
+# include <memory>
+# include <stdexcept>
+# include "utils.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Layout of the chunks of a stable_vector whose first chunk holds
+	 * B elements, B being a power of two: chunk 0 and chunk 1 hold B
+	 * elements, then each chunk holds twice as many as the previous one, so
+	 * chunk k >= 1 starts at index B << (k - 1). The chunk of an index is
+	 * found from its highest bit, without any loop.
+	*/
+	template <size_t B>
+	struct Chunk_layout
+	{
+		template <size_t N, int Dummy = 0>
+		struct log2 { static const size_t value = 1 + log2<N / 2>::value; };
+		template <int Dummy>
+		struct log2<1, Dummy> { static const size_t value = 0; };
+
+		static const size_t	shift = log2<B>::value;
+		static const size_t	chunks = sizeof(size_t) * 8 - shift + 1;
+
+		typedef char	requires_power_of_two[B != 0 && (B & (B - 1)) == 0 ? 1 : -1];
+
+		static size_t chunk_of(size_t i)
+		{
+			size_t	q = i >> shift;
+
+			return (q == 0 ? 0 : sizeof(unsigned long) * 8 - __builtin_clzl(q));
+		}
+		static size_t chunk_start(size_t k)
+		{
+			return (k == 0 ? 0 : B << (k - 1));
+		}
+		static size_t chunk_size(size_t k)
+		{
+			return (k == 0 ? B : B << (k - 1));
+		}
+	};
+
+	template <size_t B>
+	const size_t	Chunk_layout<B>::shift;
+
+	template <size_t B>
+	const size_t	Chunk_layout<B>::chunks;
+
+	template<class T, size_t B> class Stable_vector_const_iterator;
+
+	/**
+	 * @brief Random access iterator over a stable_vector. It keeps a pointer
+	 * to the element and to the end of its chunk, so stepping through a
+	 * chunk costs the same as with a vector iterator; crossing a chunk or
+	 * jumping looks the chunk up again in the vector's chunk table.
+	*/
+	template<class T, size_t B>
+	class Stable_vector_iterator
+	{
+		public:
+
+			typedef T								value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::random_access_iterator_tag	iterator_category;
+			typedef value_type*						pointer;
+			typedef value_type&						reference;
+
+		protected:
+
+			typedef Chunk_layout<B>		layout;
+
+			T* const	*m_chunks;
+			size_t		m_index;
+			T			*m_ptr;
+			T			*m_end;
+
+			void	locate(size_t index)
+			{
+				size_t	k = layout::chunk_of(index);
+				T		*base = m_chunks[k];
+
+				m_index = index;
+				m_ptr = (base ? base + (index - layout::chunk_start(k)) : NULL);
+				m_end = (base ? base + layout::chunk_size(k) : NULL);
+			}
+
+		private:
+
+			Stable_vector_iterator(const Stable_vector_const_iterator<T, B>& ) {}
+
+		public:
+
+			Stable_vector_iterator()
+			: m_chunks(NULL), m_index(0), m_ptr(NULL), m_end(NULL) {}
+			Stable_vector_iterator(T* const* chunks, size_t index)
+			: m_chunks(chunks)
+			{
+				this->locate(index);
+			}
+			Stable_vector_iterator(const Stable_vector_iterator& from)
+			: m_chunks(from.m_chunks), m_index(from.m_index),
+			m_ptr(from.m_ptr), m_end(from.m_end) {}
+			~Stable_vector_iterator() {}
+
+			T* const*	getChunks() const { return m_chunks; }
+			size_t		getIndex() const { return m_index; }
+			Stable_vector_iterator& operator=(const Stable_vector_iterator& it)
+			{
+				if (this != &it)
+				{
+					m_chunks = it.m_chunks;
+					m_index = it.m_index;
+					m_ptr = it.m_ptr;
+					m_end = it.m_end;
+				}
+				return (*this);
+			}
+
+			bool operator==(const Stable_vector_iterator& it) const
+			{
+				return (m_index == it.m_index);
+			}
+			bool operator!=(const Stable_vector_iterator& it) const
+			{
+				return (m_index != it.m_index);
+			}
+			reference operator*() const { return (*m_ptr); }
+			reference operator[](difference_type n) const
+			{
+				return (*(*this + n));
+			}
+			pointer operator->() const { return (m_ptr); }
+			Stable_vector_iterator& operator++()
+			{
+				m_index++;
+				if (++m_ptr == m_end)
+					this->locate(m_index);
+				return (*this);
+			}
+			Stable_vector_iterator operator++(int)
+			{
+				Stable_vector_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Stable_vector_iterator& operator--()
+			{
+				this->locate(m_index - 1);
+				return (*this);
+			}
+			Stable_vector_iterator operator--(int)
+			{
+				Stable_vector_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+			Stable_vector_iterator operator+(difference_type n) const
+			{
+				return (Stable_vector_iterator(m_chunks, m_index + n));
+			}
+			Stable_vector_iterator operator-(difference_type n) const
+			{
+				return (Stable_vector_iterator(m_chunks, m_index - n));
+			}
+			difference_type operator-(const Stable_vector_iterator& other) const
+			{
+				return (static_cast<difference_type>(m_index - other.m_index));
+			}
+			friend Stable_vector_iterator operator+(difference_type n,
+				const Stable_vector_iterator& other)
+			{
+				return (other.operator+(n));
+			}
+			Stable_vector_iterator& operator+=(difference_type n)
+			{
+				this->locate(m_index + n);
+				return (*this);
+			}
+			Stable_vector_iterator& operator-=(difference_type n)
+			{
+				this->locate(m_index - n);
+				return (*this);
+			}
+			bool operator<(const Stable_vector_iterator& other) const
+			{
+				return (m_index < other.m_index);
+			}
+			bool operator>(const Stable_vector_iterator& other) const
+			{
+				return (m_index > other.m_index);
+			}
+			bool operator<=(const Stable_vector_iterator& other) const
+			{
+				return (m_index <= other.m_index);
+			}
+			bool operator>=(const Stable_vector_iterator& other) const
+			{
+				return (m_index >= other.m_index);
+			}
+	};
+
+	template<class T, size_t B>
+	class Stable_vector_const_iterator : public Stable_vector_iterator<T, B>
+	{
+		public:
+
+			typedef T const &	const_reference;
+			typedef T const *	const_pointer;
+			typedef ptrdiff_t	difference_type;
+
+			Stable_vector_const_iterator() {}
+			Stable_vector_const_iterator(T* const* chunks, size_t index)
+			: Stable_vector_iterator<T, B>(chunks, index) {}
+			Stable_vector_const_iterator(const Stable_vector_iterator<T, B>& from)
+			: Stable_vector_iterator<T, B>(from.getChunks(), from.getIndex()) {}
+
+			Stable_vector_const_iterator& operator=(const Stable_vector_const_iterator& it)
+			{
+				Stable_vector_iterator<T, B>::operator=(it);
+				return (*this);
+			}
+			const_reference operator*() const { return (*this->m_ptr); }
+			const_reference operator[](difference_type n) const
+			{
+				return (*Stable_vector_const_iterator(this->m_chunks,
+					this->m_index + n));
+			}
+			const_pointer operator->() const { return (this->m_ptr); }
+	};
+
+	/**
+	 * @brief Segmented vector whose elements never move: it grows by
+	 * allocating a new chunk, each twice as large as the previous one, and
+	 * never reallocates the existing ones, so pointers and references to
+	 * its elements stay valid until they are erased. The chunk of an index
+	 * is given by its highest bit, so random access is O(1), and the chunk
+	 * table has a fixed size and lives in the object. Like ft::vector,
+	 * it only grows and shrinks at the end; capacity is kept by clear and
+	 * pop_back, and given back by shrink_to_fit. Iterators to elements
+	 * stay valid as well, but end() must be taken again after a push_back.
+	 * @tparam T Type of the elements.
+	 * @tparam B Number of elements of the first chunk, a power of two.
+	 * @tparam Alloc Type of the allocator object used to define the storage
+	 * allocation model.
+	*/
+	template <class T, size_t B = 32, class Alloc = std::allocator<T> >
+	class stable_vector
+	{
+		typedef Chunk_layout<B>		layout;
+
+		public:
+
+			typedef T											value_type;
+			typedef Alloc										allocator_type;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef Stable_vector_iterator<T, B>				iterator;
+			typedef Stable_vector_const_iterator<T, B>			const_iterator;
+			typedef ptrdiff_t									difference_type;
+			typedef size_t										size_type;
+
+		private:
+
+			pointer			_chunks[layout::chunks];
+			size_type		_allocated;
+			size_type		_size;
+			allocator_type	_alloc;
+
+		public:
+
+			/**
+			 * @brief empty container constructor (default constructor):
+			 * Nothing is allocated until the first element is inserted.
+			*/
+			explicit stable_vector(const allocator_type& alloc = allocator_type())
+			: _allocated(0), _size(0), _alloc(alloc)
+			{
+				this->init_chunks();
+			}
+
+			/**
+			 * @brief fill constructor: Constructs a container with n copies
+			 * of val.
+			*/
+			explicit stable_vector(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())
+			: _allocated(0), _size(0), _alloc(alloc)
+			{
+				this->init_chunks();
+				this->resize(n, val);
+			}
+
+			/**
+			 * @brief range constructor: Constructs a container with a copy of
+			 * each of the elements in [first,last), in the same order.
+			*/
+			template <class InputIterator>
+			stable_vector(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last,
+				const allocator_type& alloc = allocator_type())
+			: _allocated(0), _size(0), _alloc(alloc)
+			{
+				this->init_chunks();
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+			stable_vector(const stable_vector& x)
+			: _allocated(0), _size(0), _alloc(x._alloc)
+			{
+				this->init_chunks();
+				*this = x;
+			}
+
+			~stable_vector()
+			{
+				this->clear();
+				this->release(0);
+			}
+
+			stable_vector& operator=(const stable_vector& x)
+			{
+				if (this != &x)
+					this->assign(x.begin(), x.end());
+				return (*this);
+			}
+
+			/**
+			 * @brief Replaces the contents with copies of the elements of
+			 * [first,last). The chunks already allocated are reused.
+			*/
+			template <class InputIterator>
+			void assign(InputIterator first, InputIterator last)
+			{
+				this->clear();
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin() { return (iterator(_chunks, 0)); }
+			const_iterator begin() const { return (const_iterator(_chunks, 0)); }
+			iterator end() { return (iterator(_chunks, _size)); }
+			const_iterator end() const { return (const_iterator(_chunks, _size)); }
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_size == 0); }
+			size_type size() const { return (_size); }
+			size_type max_size() const { return (_alloc.max_size()); }
+
+			/**
+			 * @brief Returns the number of elements the allocated chunks can
+			 * hold.
+			*/
+			size_type capacity() const
+			{
+				return (layout::chunk_start(_allocated));
+			}
+
+			/**
+			 * @brief Allocates chunks until n elements fit. Existing elements
+			 * are not moved.
+			*/
+			void reserve(size_type n)
+			{
+				if (n > this->max_size())
+					throw std::length_error("stable_vector::reserve");
+				while (this->capacity() < n)
+					this->grow();
+			}
+
+			/**
+			 * @brief Resizes the container so that it contains n elements,
+			 * appending copies of val or destroying the last elements.
+			*/
+			void resize(size_type n, value_type val = value_type())
+			{
+				while (_size > n)
+					this->pop_back();
+				while (_size < n)
+					this->push_back(val);
+			}
+
+			/**
+			 * @brief Releases the chunks past the one holding the last
+			 * element.
+			*/
+			void shrink_to_fit()
+			{
+				this->release(_size ? layout::chunk_of(_size - 1) + 1 : 0);
+			}
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference operator[](size_type n)
+			{
+				size_type	k = layout::chunk_of(n);
+
+				return (_chunks[k][n - layout::chunk_start(k)]);
+			}
+			const_reference operator[](size_type n) const
+			{
+				size_type	k = layout::chunk_of(n);
+
+				return (_chunks[k][n - layout::chunk_start(k)]);
+			}
+
+			reference at(size_type n)
+			{
+				if (n >= _size)
+					throw std::out_of_range("stable_vector::at");
+				return ((*this)[n]);
+			}
+			const_reference at(size_type n) const
+			{
+				if (n >= _size)
+					throw std::out_of_range("stable_vector::at");
+				return ((*this)[n]);
+			}
+
+			reference front() { return (_chunks[0][0]); }
+			const_reference front() const { return (_chunks[0][0]); }
+			reference back() { return ((*this)[_size - 1]); }
+			const_reference back() const { return ((*this)[_size - 1]); }
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Appends a copy of val, allocating a new chunk when the
+			 * last one is full. No element is moved.
+			*/
+			void push_back(const value_type& val)
+			{
+				if (_size == this->capacity())
+					this->grow();
+				_alloc.construct(&(*this)[_size], val);
+				_size++;
+			}
+
+			void pop_back()
+			{
+				_size--;
+				_alloc.destroy(&(*this)[_size]);
+			}
+
+			/**
+			 * @brief Destroys every element. The chunks are kept.
+			*/
+			void clear()
+			{
+				for (size_type k = 0; _size > layout::chunk_start(k); k++)
+				{
+					size_type	n = std::min(_size, layout::chunk_start(k)
+						+ layout::chunk_size(k)) - layout::chunk_start(k);
+					for (size_type i = 0; i < n; i++)
+						_alloc.destroy(_chunks[k] + i);
+				}
+				_size = 0;
+			}
+
+			/**
+			 * @brief Exchanges the contents of both containers. Their
+			 * iterators are invalidated, as they refer to the chunk table
+			 * held in the object, but pointers and references to elements
+			 * remain valid.
+			*/
+			void swap(stable_vector& x)
+			{
+				for (size_type k = 0; k < layout::chunks; k++)
+					std::swap(_chunks[k], x._chunks[k]);
+				std::swap(_allocated, x._allocated);
+				std::swap(_size, x._size);
+				std::swap(_alloc, x._alloc);
+			}
+
+/*
+** -------------------------------- ALLOCATOR ----------------------------------
+*/
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			void	init_chunks()
+			{
+				for (size_type k = 0; k < layout::chunks; k++)
+					_chunks[k] = NULL;
+			}
+
+			/**
+			 * @brief Allocates the next chunk.
+			*/
+			void	grow()
+			{
+				_chunks[_allocated] = _alloc.allocate(layout::chunk_size(_allocated));
+				_allocated++;
+			}
+
+			/**
+			 * @brief Deallocates the chunks from the n-th one, which must not
+			 * hold any element.
+			*/
+			void	release(size_type n)
+			{
+				while (_allocated > n)
+				{
+					_allocated--;
+					_alloc.deallocate(_chunks[_allocated],
+						layout::chunk_size(_allocated));
+					_chunks[_allocated] = NULL;
+				}
+			}
+	};
+
+/*
+** -------------------------------- OVERLOADS ----------------------------------
+*/
+
+	template <class T, size_t B, class Alloc>
+	bool operator==(const stable_vector<T,B,Alloc>& lhs,
+		const stable_vector<T,B,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T, size_t B, class Alloc>
+	bool operator!=(const stable_vector<T,B,Alloc>& lhs,
+		const stable_vector<T,B,Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, size_t B, class Alloc>
+	bool operator<(const stable_vector<T,B,Alloc>& lhs,
+		const stable_vector<T,B,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+			rhs.begin(), rhs.end()));
+	}
+
+	template <class T, size_t B, class Alloc>
+	void swap(stable_vector<T,B,Alloc>& x, stable_vector<T,B,Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************* STABLE_VECTOR_HPP */
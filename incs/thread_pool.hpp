@@ -0,0 +1,236 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   thread_pool.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/22 10:05:41 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/22 10:05:41 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef THREAD_POOL_HPP
+# define THREAD_POOL_HPP
+
+# include <stdexcept>
+# include <pthread.h>
+# include <unistd.h>
+# include "mutex.hpp"
+# include "list.hpp"
+# include "vector.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Returns the number of online processors, at least 1.
+	*/
+	inline size_t	hardware_concurrency()
+	{
+		long	n = sysconf(_SC_NPROCESSORS_ONLN);
+
+		return (n > 0 ? static_cast<size_t>(n) : 1);
+	}
+
+	/**
+	 * @brief Fixed set of worker threads running tasks from a shared queue.
+	 * Tasks are submitted as part of a task_group, and the thread waiting
+	 * for a group runs queued tasks itself instead of blocking, so tasks may
+	 * submit and wait for nested groups without deadlocking the pool.
+	*/
+	class thread_pool
+	{
+		public:
+
+			typedef void	(*task_function)(void*);
+
+			/**
+			 * @brief Set of tasks that can be waited for together.
+			*/
+			class task_group
+			{
+				public:
+
+					task_group() : _pending(0), _failed(false) {}
+
+				private:
+
+					friend class thread_pool;
+
+					size_t	_pending;
+					bool	_failed;
+
+					task_group(const task_group&);
+					task_group& operator=(const task_group&);
+			};
+
+		private:
+
+			struct Task
+			{
+				task_function	fn;
+				void*			arg;
+				task_group*		group;
+			};
+
+			mutex					_mutex;
+			condition_variable		_cond;
+			ft::list<Task>			_tasks;
+			ft::vector<pthread_t>	_threads;
+			bool					_stop;
+
+			thread_pool(const thread_pool&);
+			thread_pool& operator=(const thread_pool&);
+
+		public:
+
+			/**
+			 * @brief Starts the worker threads. The thread waiting for a group
+			 * also runs tasks, so the default leaves one processor to it.
+			 * @param threads Number of worker threads, may be 0.
+			 * @throw std::runtime_error if a thread cannot be created.
+			*/
+			explicit thread_pool(size_t threads = hardware_concurrency() - 1)
+			: _stop(false)
+			{
+				_threads.reserve(threads);
+				for (size_t i = 0; i < threads; i++)
+				{
+					pthread_t	t;
+					if (pthread_create(&t, NULL, &thread_pool::worker, this) != 0)
+					{
+						this->shutdown();
+						throw std::runtime_error("thread_pool: pthread_create");
+					}
+					_threads.push_back(t);
+				}
+			}
+
+			/**
+			 * @brief Runs the tasks left in the queue, then joins the workers.
+			*/
+			~thread_pool()
+			{
+				this->shutdown();
+			}
+
+			/**
+			 * @brief Number of threads running tasks while a group is waited
+			 * for: the workers and the waiting thread.
+			*/
+			size_t concurrency() const { return (_threads.size() + 1); }
+
+			/**
+			 * @brief Queues fn(arg) as part of group.
+			 * @throw std::bad_alloc if the task cannot be queued, in which
+			 * case group is left as it was.
+			*/
+			void submit(task_group& group, task_function fn, void* arg)
+			{
+				Task	task;
+
+				task.fn = fn;
+				task.arg = arg;
+				task.group = &group;
+				lock_guard<mutex>	lock(_mutex);
+				_tasks.push_back(task);
+				group._pending++;
+				_cond.notify_all();
+			}
+
+			/**
+			 * @brief Returns once every task of group has run, running queued
+			 * tasks meanwhile.
+			 * @throw std::runtime_error if a task of the group threw.
+			*/
+			void wait(task_group& group)
+			{
+				_mutex.lock();
+				while (group._pending)
+				{
+					if (_tasks.empty())
+						_cond.wait(_mutex);
+					else
+						this->run_front();
+				}
+				bool	failed = group._failed;
+				group._failed = false;
+				_mutex.unlock();
+				if (failed)
+					throw std::runtime_error("thread_pool: a task threw");
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			/**
+			 * @brief Pops the first task and runs it with the mutex released.
+			 * The mutex must be held by the caller.
+			*/
+			void run_front()
+			{
+				Task	task = _tasks.front();
+				bool	failed = false;
+
+				_tasks.pop_front();
+				_mutex.unlock();
+				try
+				{
+					task.fn(task.arg);
+				}
+				catch (...)
+				{
+					failed = true;
+				}
+				_mutex.lock();
+				if (failed)
+					task.group->_failed = true;
+				if (--task.group->_pending == 0)
+					_cond.notify_all();
+			}
+
+			static void*	worker(void* arg)
+			{
+				thread_pool*	pool = static_cast<thread_pool*>(arg);
+
+				pool->_mutex.lock();
+				while (true)
+				{
+					if (!pool->_tasks.empty())
+						pool->run_front();
+					else if (pool->_stop)
+						break ;
+					else
+						pool->_cond.wait(pool->_mutex);
+				}
+				pool->_mutex.unlock();
+				return (NULL);
+			}
+
+			void shutdown()
+			{
+				_mutex.lock();
+				_stop = true;
+				_cond.notify_all();
+				_mutex.unlock();
+				for (size_t i = 0; i < _threads.size(); i++)
+					pthread_join(_threads[i], NULL);
+				_threads.clear();
+			}
+	};
+
+	/**
+	 * @brief Process wide pool used by the parallel algorithms when none is
+	 * given, started on first use.
+	*/
+	inline thread_pool&	default_thread_pool()
+	{
+		static thread_pool	pool;
+
+		return (pool);
+	}
+}
+
+#endif /* *************************************************** THREAD_POOL_HPP */
@@ -0,0 +1,328 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timer_wheel.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/25 10:44:06 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/25 10:44:06 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TIMER_WHEEL_HPP
+# define TIMER_WHEEL_HPP
+
+# include <memory>
+# include <stdint.h>
+# include "list.hpp"
+
+namespace ft
+{
+	/**
+	 * @brief Hierarchical timer wheel. Timers are values of type T due at a
+	 * tick, a 64-bit integer in a unit chosen by the caller. The wheel has 11
+	 * levels of 64 buckets, each an ft::list: level l holds the timers due
+	 * within 64^(l+1) ticks, sorted into buckets by the l-th group of 6 bits
+	 * of their tick. Scheduling and cancelling are O(1). When time crosses a
+	 * multiple of 64^l, the bucket of level l reached is cascaded, i.e. its
+	 * timers move to lower levels, so each timer moves at most 10 times
+	 * before it fires.
+	 * Nodes of fired and cancelled timers are kept on a spare list and
+	 * spliced back when scheduling, so a wheel in a steady state does not
+	 * allocate.
+	 * @tparam T Type of the values carried by the timers.
+	 * @tparam Alloc Type of the allocator object used by the buckets.
+	*/
+	template <class T, class Alloc = std::allocator<T> >
+	class timer_wheel
+	{
+		public:
+
+			typedef T			value_type;
+			typedef uint64_t	time_type;
+			typedef size_t		size_type;
+
+			static const unsigned	bits = 6;
+			static const unsigned	slots = 1U << bits;
+			static const unsigned	levels = (64 + bits - 1) / bits;
+
+		private:
+
+			struct Entry
+			{
+				time_type	expires;
+				unsigned	bucket;
+				size_t		generation;
+				T			val;
+
+				Entry(const T& v) : expires(0), bucket(0), generation(0), val(v) {}
+			};
+
+			typedef typename Alloc::template rebind<Entry>::other	Entry_allocator;
+			typedef ft::list<Entry, Entry_allocator>				Bucket;
+			typedef typename Bucket::iterator						Bucket_iterator;
+
+			static const unsigned	spare = levels * slots;
+			static const time_type	mask = slots - 1;
+
+		public:
+
+			/**
+			 * @brief Refers to a scheduled timer. A handle becomes stale once
+			 * its timer fires or is cancelled, even if its node is reused.
+			*/
+			class handle
+			{
+				public:
+
+					handle() : _it(), _generation(0) {}
+
+				private:
+
+					friend class timer_wheel;
+
+					Bucket_iterator	_it;
+					size_t			_generation;
+
+					handle(Bucket_iterator it, size_t generation)
+					: _it(it), _generation(generation) {}
+			};
+
+		private:
+
+			Bucket		_buckets[levels * slots + 1];
+			uint64_t	_occupied[levels];
+			time_type	_now;
+			size_type	_size;
+
+			timer_wheel(const timer_wheel&);
+			timer_wheel& operator=(const timer_wheel&);
+
+		public:
+
+			/**
+			 * @brief Constructs an empty wheel.
+			 * @param now First tick that tick() will process.
+			*/
+			explicit timer_wheel(time_type now = 0) : _now(now), _size(0)
+			{
+				for (unsigned l = 0; l < levels; l++)
+					_occupied[l] = 0;
+			}
+
+			~timer_wheel() {}
+
+			/**
+			 * @brief Returns the number of scheduled timers.
+			*/
+			size_type size() const { return (_size); }
+			bool empty() const { return (_size == 0); }
+
+			/**
+			 * @brief Returns the next tick tick() will process.
+			*/
+			time_type now() const { return (_now); }
+
+			/**
+			 * @brief Schedules val to fire at tick expires, or at the next
+			 * processed tick if expires is already past. O(1).
+			 * @return A handle to cancel the timer.
+			*/
+			handle schedule(time_type expires, const value_type& val)
+			{
+				Bucket&			spares = _buckets[spare];
+				Bucket_iterator	it;
+
+				if (spares.empty())
+					spares.push_back(Entry(val));
+				else
+					spares.back().val = val;
+				it = --spares.end();
+				it->expires = (expires < _now ? _now : expires);
+				it->generation++;
+				this->place(it, spares);
+				_size++;
+				return (handle(it, it->generation));
+			}
+
+			/**
+			 * @brief Tells whether the timer of h is still scheduled.
+			*/
+			bool pending(const handle& h) const
+			{
+				return (h._it != Bucket_iterator() && h._it->bucket != spare
+					&& h._it->generation == h._generation);
+			}
+
+			/**
+			 * @brief Cancels the timer of h, in O(1).
+			 * @return false if it already fired or was cancelled.
+			*/
+			bool cancel(const handle& h)
+			{
+				if (!this->pending(h))
+					return (false);
+				this->retire(h._it);
+				return (true);
+			}
+
+			/**
+			 * @brief Processes every tick up to now included, writing the
+			 * values of the timers due to out, in tick order. Ticks on which
+			 * nothing fires or cascades are skipped using bitmaps of the
+			 * occupied buckets, so a long jump costs at most a few steps per
+			 * level.
+			 * @return The number of timers fired.
+			*/
+			template <class OutputIterator>
+			size_type tick(time_type now, OutputIterator out)
+			{
+				size_type	fired = 0;
+
+				while (_now <= now)
+				{
+					if (_size == 0)
+					{
+						_now = now + 1;
+						break ;
+					}
+					unsigned	slot = _now & mask;
+					if (slot == 0)
+						this->cascade();
+					Bucket&		bucket = _buckets[slot];
+					while (!bucket.empty())
+					{
+						*out = bucket.front().val;
+						++out;
+						++fired;
+						this->retire(bucket.begin());
+					}
+					time_type	next = this->next_event();
+					if (next > now || next <= _now)
+					{
+						_now = now + 1;
+						break ;
+					}
+					_now = next;
+				}
+				return (fired);
+			}
+
+			/**
+			 * @brief Cancels every timer and releases every node. Handles
+			 * obtained before must not be used anymore.
+			*/
+			void clear()
+			{
+				for (unsigned i = 0; i <= spare; i++)
+					_buckets[i].clear();
+				for (unsigned l = 0; l < levels; l++)
+					_occupied[l] = 0;
+				_size = 0;
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+		private:
+
+			/**
+			 * @brief Moves the timer at it from its list from into the bucket
+			 * matching its tick: the level is given by the highest group of
+			 * bits in which its tick differs from the current one.
+			*/
+			void place(Bucket_iterator it, Bucket& from)
+			{
+				time_type	diff = it->expires ^ _now;
+				unsigned	level = (diff < slots ? 0
+					: (63 - __builtin_clzll(diff)) / bits);
+				unsigned	slot = (it->expires >> (level * bits)) & mask;
+				Bucket&		to = _buckets[level * slots + slot];
+
+				to.splice(to.end(), from, it);
+				it->bucket = level * slots + slot;
+				_occupied[level] |= static_cast<uint64_t>(1) << slot;
+			}
+
+			/**
+			 * @brief Moves the timer at it to the spare list.
+			*/
+			void retire(Bucket_iterator it)
+			{
+				unsigned	b = it->bucket;
+				Bucket&		from = _buckets[b];
+
+				_buckets[spare].splice(_buckets[spare].end(), from, it);
+				it->bucket = spare;
+				it->generation++;
+				if (from.empty())
+					_occupied[b / slots] &= ~(static_cast<uint64_t>(1) << (b % slots));
+				_size--;
+			}
+
+			/**
+			 * @brief Returns the first tick after the current one on which a
+			 * timer fires or a bucket cascades: the next occupied bucket of
+			 * the lowest level in the current block of 64 ticks or, when
+			 * there is none, the earliest next occupied bucket of a higher
+			 * level. Skipped boundaries only reach empty buckets, as a timer
+			 * never sits before the current bucket of its level.
+			*/
+			time_type next_event() const
+			{
+				unsigned	slot = _now & mask;
+				uint64_t	later = (slot + 1 < slots ?
+					_occupied[0] & (~static_cast<uint64_t>(0) << (slot + 1)) : 0);
+				time_type	next = 0;
+
+				if (later)
+					return ((_now & ~mask) + __builtin_ctzll(later));
+				for (unsigned l = 1; l < levels; l++)
+				{
+					unsigned	shift = l * bits;
+					slot = (_now >> shift) & mask;
+					later = (slot + 1 < slots ?
+						_occupied[l] & (~static_cast<uint64_t>(0) << (slot + 1)) : 0);
+					if (!later)
+						continue ;
+					time_type	at = ((_now >> shift) & ~mask) << shift;
+					at += static_cast<time_type>(__builtin_ctzll(later)) << shift;
+					if (next == 0 || at < next)
+						next = at;
+				}
+				return (next);
+			}
+
+			/**
+			 * @brief Called when the current tick is a multiple of 64: for
+			 * each level whose bits just changed, spreads the bucket reached
+			 * over the lower levels.
+			*/
+			void cascade()
+			{
+				for (unsigned l = 1; l < levels; l++)
+				{
+					unsigned	slot = (_now >> (l * bits)) & mask;
+					Bucket&		bucket = _buckets[l * slots + slot];
+
+					_occupied[l] &= ~(static_cast<uint64_t>(1) << slot);
+					while (!bucket.empty())
+						this->place(bucket.begin(), bucket);
+					if (slot != 0 || ((_now >> (l * bits)) & ~mask) == 0)
+						break ;
+				}
+			}
+	};
+
+	template <class T, class Alloc>
+	const unsigned	timer_wheel<T,Alloc>::bits;
+
+	template <class T, class Alloc>
+	const unsigned	timer_wheel<T,Alloc>::slots;
+
+	template <class T, class Alloc>
+	const unsigned	timer_wheel<T,Alloc>::levels;
+}
+
+#endif /* *************************************************** TIMER_WHEEL_HPP */
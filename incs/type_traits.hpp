@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   type_traits.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/20 09:51:33 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/20 09:51:33 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TYPE_TRAITS_HPP
+# define TYPE_TRAITS_HPP
+
+namespace ft
+{
+	/**
+	 * @brief Wraps a compile-time boolean into a type, so that overloads can
+	 * be selected on it (tag dispatching).
+	*/
+	template <bool B>
+	struct bool_constant
+	{
+		static const bool	value = B;
+		typedef bool_constant	type;
+	};
+
+	template <bool B>
+	const bool	bool_constant<B>::value;
+
+	typedef bool_constant<true>		true_type;
+	typedef bool_constant<false>	false_type;
+
+	template <class T> struct remove_cv { typedef T type; };
+	template <class T> struct remove_cv<const T> { typedef T type; };
+	template <class T> struct remove_cv<volatile T> { typedef T type; };
+	template <class T> struct remove_cv<const volatile T> { typedef T type; };
+
+	template <class T> struct is_integral_base : public false_type {};
+	template <> struct is_integral_base<bool> : public true_type {};
+	template <> struct is_integral_base<char> : public true_type {};
+	template <> struct is_integral_base<signed char> : public true_type {};
+	template <> struct is_integral_base<unsigned char> : public true_type {};
+	template <> struct is_integral_base<wchar_t> : public true_type {};
+	template <> struct is_integral_base<short> : public true_type {};
+	template <> struct is_integral_base<unsigned short> : public true_type {};
+	template <> struct is_integral_base<int> : public true_type {};
+	template <> struct is_integral_base<unsigned int> : public true_type {};
+	template <> struct is_integral_base<long> : public true_type {};
+	template <> struct is_integral_base<unsigned long> : public true_type {};
+
+	/**
+	 * @brief Tells whether T is an integral type.
+	*/
+	template <class T>
+	struct is_integral
+	: public is_integral_base<typename remove_cv<T>::type> {};
+
+	template <class T> struct is_floating_point_base : public false_type {};
+	template <> struct is_floating_point_base<float> : public true_type {};
+	template <> struct is_floating_point_base<double> : public true_type {};
+	template <> struct is_floating_point_base<long double> : public true_type {};
+
+	/**
+	 * @brief Tells whether T is a floating point type.
+	*/
+	template <class T>
+	struct is_floating_point
+	: public is_floating_point_base<typename remove_cv<T>::type> {};
+
+	/**
+	 * @brief Tells whether T is an integral or floating point type.
+	*/
+	template <class T>
+	struct is_arithmetic
+	: public bool_constant<is_integral<T>::value || is_floating_point<T>::value> {};
+
+	template <class T> struct is_pointer_base : public false_type {};
+	template <class T> struct is_pointer_base<T*> : public true_type {};
+
+	/**
+	 * @brief Tells whether T is a pointer type.
+	*/
+	template <class T>
+	struct is_pointer
+	: public is_pointer_base<typename remove_cv<T>::type> {};
+
+	/**
+	 * @brief Tells whether T can be copied byte-wise and has a trivial
+	 * destructor, so that its object representation can be stored in a file
+	 * and mapped back. True for arithmetic and pointer types, user types (PODs)
+	 * opt in by specialising this trait.
+	*/
+	template <class T>
+	struct is_trivially_copyable
+	: public bool_constant<is_arithmetic<T>::value || is_pointer<T>::value> {};
+
+	/**
+	 * @brief Tells whether an object of type T can be moved to another
+	 * address by copying its bytes, without calling its copy constructor and
+	 * destructor. True for trivially copyable types, other user types opt in
+	 * by specialising this trait.
+	*/
+	template <class T>
+	struct is_trivially_relocatable
+	: public bool_constant<is_trivially_copyable<T>::value> {};
+}
+
+#endif /* *************************************************** TYPE_TRAITS_HPP */
@@ -0,0 +1,749 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   unrolled_list.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nforay <nforay@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/07/26 14:05:52 by nforay            #+#    #+#             */
+/*   Updated: 2021/07/26 14:05:52 by nforay           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UNROLLED_LIST_HPP
+# define UNROLLED_LIST_HPP
+
+# include <stddef.h>
+# include <stdint.h>
+# include <iterator>
+# include <limits>
+# include <memory>
+# include "utils.hpp"
+
+namespace ft
+{
+	template<class T, typename Block> class Unrolled_list_const_iterator;
+
+	/**
+	 * @brief Iterator over an unrolled_list: the block holding the element
+	 * and the element's index within the block's array.
+	*/
+	template<class T, typename Block>
+	class Unrolled_list_iterator
+	{
+		public:
+
+			typedef T								value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef std::bidirectional_iterator_tag	iterator_category;
+			typedef value_type*						pointer;
+			typedef value_type&						reference;
+			typedef Block*							NodePtr;
+
+		protected:
+
+			NodePtr	m_node;
+			size_t	m_index;
+
+		private:
+
+			Unrolled_list_iterator(const Unrolled_list_const_iterator<T, Block>& ) {}
+
+		public:
+
+			Unrolled_list_iterator(NodePtr node = NULL, size_t index = 0)
+			: m_node(node), m_index(index) {}
+			Unrolled_list_iterator(const Unrolled_list_iterator& from)
+			: m_node(from.m_node), m_index(from.m_index) {}
+			~Unrolled_list_iterator() {}
+
+			NodePtr	getNode() const { return m_node; }
+			size_t	getIndex() const { return m_index; }
+			Unrolled_list_iterator& operator=(const Unrolled_list_iterator& it)
+			{
+				if (this != &it)
+				{
+					m_node = it.m_node;
+					m_index = it.m_index;
+				}
+				return (*this);
+			}
+
+			bool operator==(const Unrolled_list_iterator& it) const
+			{
+				return (m_node == it.m_node && m_index == it.m_index);
+			}
+			bool operator!=(const Unrolled_list_iterator& it) const
+			{
+				return (!(*this == it));
+			}
+			reference operator*() const { return (m_node->data()[m_index]); }
+			pointer operator->() const { return (m_node->data() + m_index); }
+			Unrolled_list_iterator& operator++()
+			{
+				if (++m_index == m_node->first + m_node->count)
+				{
+					m_node = m_node->next;
+					m_index = m_node->first;
+				}
+				return (*this);
+			}
+			Unrolled_list_iterator operator++(int)
+			{
+				Unrolled_list_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+			Unrolled_list_iterator& operator--()
+			{
+				if (m_index == m_node->first)
+				{
+					m_node = m_node->prev;
+					m_index = m_node->first + m_node->count;
+				}
+				--m_index;
+				return (*this);
+			}
+			Unrolled_list_iterator operator--(int)
+			{
+				Unrolled_list_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+	};
+
+	template<class T, typename Block>
+	class Unrolled_list_const_iterator : public Unrolled_list_iterator<T, Block>
+	{
+		public:
+
+			typedef T const &	const_reference;
+			typedef T const *	const_pointer;
+			typedef Block*		NodePtr;
+
+			Unrolled_list_const_iterator(NodePtr node, size_t index)
+			{
+				this->m_node = node;
+				this->m_index = index;
+			}
+			Unrolled_list_const_iterator(const Unrolled_list_iterator<T, Block>& from)
+			{
+				this->m_node = from.getNode();
+				this->m_index = from.getIndex();
+			}
+
+			Unrolled_list_const_iterator& operator=(const Unrolled_list_const_iterator& it)
+			{
+				if (this != &it)
+				{
+					this->m_node = it.m_node;
+					this->m_index = it.m_index;
+				}
+				return (*this);
+			}
+			const_reference operator*() const
+			{
+				return (this->m_node->data()[this->m_index]);
+			}
+			const_pointer operator->() const
+			{
+				return (this->m_node->data() + this->m_index);
+			}
+	};
+
+	/**
+	 * @brief Unrolled linked list: a doubly-linked list of blocks, each
+	 * holding up to K elements in an inline array, so a scan touches one
+	 * node per K elements instead of one per element. The elements of a
+	 * block occupy a contiguous run of its array, which can start anywhere:
+	 * pushing at either end fills the free side of the end block, so both
+	 * are O(1). Inserting and erasing shift the shorter side of the run
+	 * within a single block; a full block is split in two halves, and a
+	 * block whose elements fit in half a block together with those of its
+	 * successor absorbs them, so erasing does not leave long chains of
+	 * nearly empty blocks.
+	 * Inserting and erasing invalidate the iterators to the block they
+	 * touch and to the one after it.
+	 * @tparam T Type of the elements.
+	 * @tparam K Number of elements per block, by default as many as fit in
+	 * 512 bytes, and at least 8.
+	 * @tparam Alloc Type of the allocator object used to define the storage
+	 * allocation model.
+	*/
+	template <class T, size_t K = (sizeof(T) <= 64 ? 512 / sizeof(T) : 8),
+		class Alloc = std::allocator<T> >
+	class unrolled_list
+	{
+		struct Block;
+
+		struct Block_links
+		{
+			Block*		next;
+			Block*		prev;
+			size_t		first;
+			size_t		count;
+		};
+
+		struct Block : public Block_links
+		{
+			union
+			{
+				char		raw[K * sizeof(T)];
+				long double	align_float;
+				int64_t		align_int;
+				void		*align_ptr;
+			}			storage;
+
+			T*	data() { return (reinterpret_cast<T*>(storage.raw)); }
+		};
+
+		typedef char	requires_two_elements_per_block[K >= 2 ? 1 : -1];
+
+		public:
+
+			typedef T											value_type;
+			typedef Alloc										allocator_type;
+			typedef typename Alloc::template
+			rebind<Block>::other								Block_allocator;
+			typedef typename allocator_type::reference			reference;
+			typedef typename allocator_type::const_reference	const_reference;
+			typedef typename allocator_type::pointer			pointer;
+			typedef typename allocator_type::const_pointer		const_pointer;
+			typedef Unrolled_list_iterator<T, Block>			iterator;
+			typedef Unrolled_list_const_iterator<T, Block>		const_iterator;
+			typedef ptrdiff_t									difference_type;
+			typedef size_t										size_type;
+
+			static const size_type	block_size = K;
+
+		private:
+
+			size_type		_size;
+			allocator_type	_alloc;
+			Block_links		_sentinel;
+			Block*			_head;
+
+		public:
+
+			/**
+			 * @brief empty container constructor (default constructor):
+			 * Constructs an empty container, with no elements. Nothing is
+			 * allocated until the first element is inserted.
+			 * @param alloc Allocator object.
+			*/
+			explicit unrolled_list(const allocator_type& alloc = allocator_type())
+			: _size(0), _alloc(alloc), _head(sentinel()) {}
+
+			/**
+			 * @brief fill constructor: Constructs a container with n copies
+			 * of val.
+			*/
+			explicit unrolled_list(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())
+			: _size(0), _alloc(alloc), _head(sentinel())
+			{
+				while (n--)
+					this->push_back(val);
+			}
+
+			/**
+			 * @brief range constructor: Constructs a container with a copy of
+			 * each of the elements in [first,last), in the same order.
+			*/
+			template <class InputIterator>
+			unrolled_list(typename ft::enable_if<!std::numeric_limits<InputIterator>
+				::is_integer, InputIterator>::type first, InputIterator last,
+				const allocator_type& alloc = allocator_type())
+			: _size(0), _alloc(alloc), _head(sentinel())
+			{
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+			/**
+			 * @brief copy constructor: the copy has its blocks filled.
+			*/
+			unrolled_list(const unrolled_list& x)
+			: _size(0), _alloc(x._alloc), _head(sentinel())
+			{
+				*this = x;
+			}
+
+			~unrolled_list()
+			{
+				this->clear();
+			}
+
+			unrolled_list& operator=(const unrolled_list& x)
+			{
+				if (this != &x)
+					this->assign(x.begin(), x.end());
+				return (*this);
+			}
+
+			/**
+			 * @brief Replaces the contents with copies of the elements of
+			 * [first,last).
+			*/
+			template <class InputIterator>
+			void assign(InputIterator first, InputIterator last)
+			{
+				this->clear();
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+/*
+** --------------------------------- ITERATORS ---------------------------------
+*/
+
+			iterator begin()
+			{
+				return (iterator(_head->next, _head->next->first));
+			}
+			const_iterator begin() const
+			{
+				return (const_iterator(_head->next, _head->next->first));
+			}
+			iterator end() { return (iterator(_head, 0)); }
+			const_iterator end() const { return (const_iterator(_head, 0)); }
+
+/*
+** --------------------------------- CAPACITY ----------------------------------
+*/
+
+			bool empty() const { return (_size == 0); }
+			size_type size() const { return (_size); }
+			size_type max_size() const { return (_alloc.max_size()); }
+
+/*
+** ------------------------------ ELEMENT ACCESS -------------------------------
+*/
+
+			reference front() { return (_head->next->data()[_head->next->first]); }
+			const_reference front() const
+			{
+				return (_head->next->data()[_head->next->first]);
+			}
+			reference back()
+			{
+				return (_head->prev->data()[_head->prev->first
+					+ _head->prev->count - 1]);
+			}
+			const_reference back() const
+			{
+				return (_head->prev->data()[_head->prev->first
+					+ _head->prev->count - 1]);
+			}
+
+/*
+** -------------------------------- MODIFIERS ----------------------------------
+*/
+
+			/**
+			 * @brief Inserts a copy of val at the beginning, in O(1): in the
+			 * free space before the first element of the first block, or at
+			 * the end of a new block.
+			*/
+			void push_front(const value_type& val)
+			{
+				Block	*b = _head->next;
+
+				if (b == _head || b->first == 0)
+					b = this->block_create(b, K);
+				try
+				{
+					_alloc.construct(b->data() + b->first - 1, val);
+				}
+				catch (...)
+				{
+					if (b->count == 0)
+						this->block_destroy(b);
+					throw;
+				}
+				b->first--;
+				b->count++;
+				_size++;
+			}
+
+			/**
+			 * @brief Inserts a copy of val at the end, in O(1): in the free
+			 * space after the last element of the last block, or at the
+			 * beginning of a new block.
+			*/
+			void push_back(const value_type& val)
+			{
+				Block	*b = _head->prev;
+
+				if (b == _head || b->first + b->count == K)
+					b = this->block_create(_head, 0);
+				try
+				{
+					_alloc.construct(b->data() + b->first + b->count, val);
+				}
+				catch (...)
+				{
+					if (b->count == 0)
+						this->block_destroy(b);
+					throw;
+				}
+				b->count++;
+				_size++;
+			}
+
+			void pop_front()
+			{
+				Block	*b = _head->next;
+
+				_alloc.destroy(b->data() + b->first);
+				b->first++;
+				_size--;
+				if (--b->count == 0)
+					this->block_destroy(b);
+			}
+
+			void pop_back()
+			{
+				Block	*b = _head->prev;
+
+				_alloc.destroy(b->data() + b->first + b->count - 1);
+				_size--;
+				if (--b->count == 0)
+					this->block_destroy(b);
+			}
+
+			/**
+			 * @brief Inserts a copy of val before position, shifting the
+			 * shorter side of its block, or splitting the block if it is
+			 * full. O(K).
+			 * @return An iterator to the new element.
+			*/
+			iterator insert(iterator position, const value_type& val)
+			{
+				Block	*b = position.getNode();
+				size_t	i = position.getIndex();
+
+				if (b == _head || i == b->first)
+				{
+					Block	*prev = b->prev;
+					if (prev != _head && prev->first + prev->count < K)
+					{
+						b = prev;
+						i = b->first + b->count;
+					}
+					else if (b == _head)
+					{
+						this->push_back(val);
+						return (iterator(_head->prev,
+							_head->prev->first + _head->prev->count - 1));
+					}
+				}
+				if (b->count == K)
+				{
+					Block	*half = this->block_create(b->next, 0);
+					this->block_move(half, 0, b, b->first + K / 2, K - K / 2);
+					b->count = K / 2;
+					if (i > b->first + K / 2)
+					{
+						i -= b->first + K / 2;
+						b = half;
+					}
+				}
+				i = this->block_open(b, i);
+				try
+				{
+					_alloc.construct(b->data() + i, val);
+				}
+				catch (...)
+				{
+					this->block_close(b, i);
+					throw;
+				}
+				_size++;
+				return (iterator(b, i));
+			}
+
+			/**
+			 * @brief Inserts n copies of val before position. Each copy is
+			 * inserted before the previous one, whose iterator stays valid.
+			 * @return An iterator to the first new element.
+			*/
+			iterator insert(iterator position, size_type n, const value_type& val)
+			{
+				while (n--)
+					position = this->insert(position, val);
+				return (position);
+			}
+
+			/**
+			 * @brief Removes the element at position, shifting the shorter
+			 * side of its block. A block emptied is released, and a block
+			 * left at most half full is merged with its successor when both
+			 * fit in half a block. O(K).
+			 * @return An iterator to the element that followed it.
+			*/
+			iterator erase(iterator position)
+			{
+				Block	*b = position.getNode();
+				size_t	i = position.getIndex();
+
+				_alloc.destroy(b->data() + i);
+				_size--;
+				i = this->block_close(b, i);
+				if (b->count == 0)
+				{
+					Block	*next = b->next;
+					this->block_destroy(b);
+					return (iterator(next, next->first));
+				}
+				Block	*next = b->next;
+				if (next != _head && b->count + next->count <= K / 2)
+				{
+					size_t	offset = i - b->first;
+					bool	in_next = (i == b->first + b->count);
+					size_t	moved = b->count;
+					if (b->first != 0)
+						this->block_move(b, 0, b, b->first, b->count);
+					b->first = 0;
+					this->block_move(b, b->count, next, next->first, next->count);
+					this->block_destroy(next);
+					return (iterator(b, in_next ? moved : offset));
+				}
+				if (i == b->first + b->count)
+					return (iterator(next, next->first));
+				return (iterator(b, i));
+			}
+
+			iterator erase(iterator first, iterator last)
+			{
+				size_type	n = 0;
+
+				for (iterator it = first; it != last; ++it)
+					n++;
+				while (n--)
+					first = this->erase(first);
+				return (first);
+			}
+
+			void swap(unrolled_list& x)
+			{
+				Block_links	tmp = _sentinel;
+				size_type	size = _size;
+				allocator_type	alloc = _alloc;
+
+				_sentinel = x._sentinel;
+				x._sentinel = tmp;
+				_size = x._size;
+				x._size = size;
+				_alloc = x._alloc;
+				x._alloc = alloc;
+				this->relink_sentinel();
+				x.relink_sentinel();
+			}
+
+			/**
+			 * @brief Destroys every element and releases every block.
+			*/
+			void clear()
+			{
+				while (_head->next != _head)
+				{
+					Block	*b = _head->next;
+					for (size_t i = b->first; i < b->first + b->count; i++)
+						_alloc.destroy(b->data() + i);
+					_size -= b->count;
+					b->count = 0;
+					this->block_destroy(b);
+				}
+			}
+
+/*
+** -------------------------------- ALLOCATOR ----------------------------------
+*/
+
+			allocator_type get_allocator() const
+			{
+				return (_alloc);
+			}
+
+/*
+** ---------------------------- PRIVATE FUNCTIONS ------------------------------
+*/
+
+		private:
+
+			Block*	sentinel()
+			{
+				_sentinel.next = static_cast<Block*>(&_sentinel);
+				_sentinel.prev = static_cast<Block*>(&_sentinel);
+				_sentinel.first = 0;
+				_sentinel.count = 0;
+				return (static_cast<Block*>(&_sentinel));
+			}
+
+			/**
+			 * @brief Points the first and last blocks back to this list's
+			 * sentinel after its links were exchanged with another list.
+			*/
+			void	relink_sentinel()
+			{
+				if (_size == 0)
+				{
+					_sentinel.next = _head;
+					_sentinel.prev = _head;
+					return ;
+				}
+				_sentinel.next->prev = _head;
+				_sentinel.prev->next = _head;
+			}
+
+			/**
+			 * @brief Allocates an empty block and links it before next.
+			 * @param first Where its run of elements starts.
+			*/
+			Block*	block_create(Block* next, size_t first)
+			{
+				Block	*b = Block_allocator(_alloc).allocate(1);
+
+				b->first = first;
+				b->count = 0;
+				b->next = next;
+				b->prev = next->prev;
+				next->prev->next = b;
+				next->prev = b;
+				return (b);
+			}
+
+			/**
+			 * @brief Unlinks and releases b, whose elements are destroyed.
+			*/
+			void	block_destroy(Block* b)
+			{
+				b->prev->next = b->next;
+				b->next->prev = b->prev;
+				Block_allocator(_alloc).deallocate(b, 1);
+			}
+
+			/**
+			 * @brief Moves n elements of src from index si to index di of
+			 * dst, copying each one before destroying its source. The ranges
+			 * may overlap when moving to the front of the same block.
+			*/
+			void	block_move(Block* dst, size_t di, Block* src, size_t si,
+				size_t n)
+			{
+				for (size_t k = 0; k < n; k++)
+				{
+					_alloc.construct(dst->data() + di + k, src->data()[si + k]);
+					_alloc.destroy(src->data() + si + k);
+				}
+				if (dst != src)
+				{
+					dst->count += n;
+					src->count -= n;
+				}
+			}
+
+			/**
+			 * @brief Makes room for one element at index i of b, which is not
+			 * full, by shifting the elements after it right, or those before
+			 * it left when the run touches the end of the array.
+			 * @return The index of the free slot, left unconstructed.
+			*/
+			size_t	block_open(Block* b, size_t i)
+			{
+				T		*d = b->data();
+				size_t	end = b->first + b->count;
+
+				if (end < K && (end - i <= i - b->first || b->first == 0))
+				{
+					for (size_t k = end; k > i; k--)
+					{
+						_alloc.construct(d + k, d[k - 1]);
+						_alloc.destroy(d + k - 1);
+					}
+				}
+				else
+				{
+					for (size_t k = b->first; k < i; k++)
+					{
+						_alloc.construct(d + k - 1, d[k]);
+						_alloc.destroy(d + k);
+					}
+					b->first--;
+					i--;
+				}
+				b->count++;
+				return (i);
+			}
+
+			/**
+			 * @brief Closes the hole left by the element destroyed at index i
+			 * of b, shifting the shorter side of the run.
+			 * @return The index of the element that followed it.
+			*/
+			size_t	block_close(Block* b, size_t i)
+			{
+				T		*d = b->data();
+				size_t	end = b->first + b->count;
+
+				b->count--;
+				if (i - b->first < end - i - 1)
+				{
+					for (size_t k = i; k > b->first; k--)
+					{
+						_alloc.construct(d + k, d[k - 1]);
+						_alloc.destroy(d + k - 1);
+					}
+					b->first++;
+					return (i + 1);
+				}
+				for (size_t k = i + 1; k < end; k++)
+				{
+					_alloc.construct(d + k - 1, d[k]);
+					_alloc.destroy(d + k);
+				}
+				return (i);
+			}
+	};
+
+	template <class T, size_t K, class Alloc>
+	const typename unrolled_list<T,K,Alloc>::size_type
+		unrolled_list<T,K,Alloc>::block_size;
+
+/*
+** -------------------------------- OVERLOADS ----------------------------------
+*/
+
+	template <class T, size_t K, class Alloc>
+	bool operator==(const unrolled_list<T,K,Alloc>& lhs,
+		const unrolled_list<T,K,Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class T, size_t K, class Alloc>
+	bool operator!=(const unrolled_list<T,K,Alloc>& lhs,
+		const unrolled_list<T,K,Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, size_t K, class Alloc>
+	bool operator<(const unrolled_list<T,K,Alloc>& lhs,
+		const unrolled_list<T,K,Alloc>& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+			rhs.begin(), rhs.end()));
+	}
+
+	template <class T, size_t K, class Alloc>
+	void swap(unrolled_list<T,K,Alloc>& x, unrolled_list<T,K,Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif /* ************************************************* UNROLLED_LIST_HPP */
@@ -17,6 +17,9 @@
 # include <limits>
 # include <stdexcept>
 # include "utils.hpp"
+# include "growth_policy.hpp"
+# include "type_traits.hpp"
+# include "malloc_allocator.hpp"
 # include "vector_iterators.hpp"
 
 namespace ft
@@ -28,14 +31,19 @@ namespace ft
 	 * @tparam Alloc Type of the allocator object used to define the storage
 	 * allocation model. By default, the allocator class template is used, which
 	 * defines the simplest memory allocation model and is value-independent.
+	 * @tparam Growth Growth policy deciding the new capacity when the vector
+	 * runs out of storage (see growth_policy.hpp). By default, the capacity
+	 * is doubled.
 	*/
-	template <class T, class Alloc = std::allocator<T> >
+	template <class T, class Alloc = std::allocator<T>,
+		class Growth = growth_double>
 	class vector
 	{
 		public:
 
 			typedef T											value_type;
 			typedef Alloc										allocator_type;
+			typedef Growth										growth_policy;
 			typedef typename allocator_type::reference			reference;
 			typedef typename allocator_type::const_reference	const_reference;
 			typedef typename allocator_type::pointer			pointer;
@@ -58,15 +66,13 @@ namespace ft
 
 			/**
 			 * @brief empty container constructor (default constructor):
-			 * Constructs an empty container, with no elements.
+			 * Constructs an empty container, with no elements. No storage is
+			 * allocated until the first element is inserted.
 			 * @param alloc Allocator object. The container keeps and uses an
 			 * internal copy of this allocator.
 			*/
 			explicit vector(const allocator_type& alloc = allocator_type())
-			: _size(0), _capacity(1), _alloc(alloc)
-			{
-				_head = _alloc.allocate(1);
-			}
+			: _size(0), _capacity(0), _alloc(alloc), _head(NULL) {}
 
 			/**
 			 * @brief fill constructor: Constructs a container with n elements.
@@ -81,9 +87,10 @@ namespace ft
 			*/
 			explicit vector(size_type n, const value_type& val = value_type(),
 				const allocator_type& alloc = allocator_type())
-				: _size(n), _capacity(n), _alloc(alloc)
+				: _size(n), _capacity(n), _alloc(alloc), _head(NULL)
 			{
-				_head = _alloc.allocate(_capacity);
+				if (_capacity)
+					_head = _alloc.allocate(_capacity);
 				for (size_type i = 0; i < _size; i++)
 					_alloc.construct(&_head[i], val);
 			}
@@ -103,7 +110,7 @@ namespace ft
 			vector(typename ft::enable_if<!std::numeric_limits<InputIterator>
 				::is_integer, InputIterator>::type first, InputIterator last,
 				const allocator_type& alloc = allocator_type())
-			: _size(0), _capacity(0), _alloc(alloc)
+			: _size(0), _capacity(0), _alloc(alloc), _head(NULL)
 			{
 				this->assign(first, last);
 			}
@@ -116,10 +123,11 @@ namespace ft
 			 * copied or acquired.
 			*/
 			vector(const vector& x) : _size(x._size), _capacity(x._capacity),
-				_alloc(x._alloc)
+				_alloc(x._alloc), _head(NULL)
 			{
-				_head = _alloc.allocate(_capacity);
-				for (size_type i = 0; i < _capacity; i++)
+				if (_capacity)
+					_head = _alloc.allocate(_capacity);
+				for (size_type i = 0; i < _size; i++)
 					_alloc.construct(&_head[i], x._head[i]);
 			}
 
@@ -132,7 +140,8 @@ namespace ft
 			{
 				for (size_type i = 0; i < _size; i++)
 					_alloc.destroy(&_head[i]);
-				_alloc.deallocate(_head, _capacity);
+				if (_capacity)
+					_alloc.deallocate(_head, _capacity);
 			}
 
 			/**
@@ -301,8 +310,9 @@ namespace ft
 			 * elements as needed to reach a size of n. If val is specified,
 			 * the new elements are initialized as copies of val, otherwise,
 			 * they are value-initialized. If n is also greater than the current
-			 * container capacity, an automatic reallocation of the allocated
-			 * storage space takes place.
+			 * container capacity, the storage is reallocated to the capacity
+			 * chosen by the growth policy, so that growing one element at a
+			 * time stays amortized.
 			 * @param n New container size, expressed in number of elements.
 			 * @param val Object whose content is copied to the added elements
 			 * in case that n is greater than the current container size. If not
@@ -311,7 +321,7 @@ namespace ft
 			void resize(size_type n, value_type val = value_type())
 			{
 				if (n > _capacity)
-					reallocate(n);
+					reallocate(grow(n));
 				while (n > _size)
 					push_back(val);
 				while (n < _size)
@@ -591,6 +601,8 @@ namespace ft
 				difference_type shift = position - this->begin();
 				difference_type tmp = this->end() - this->begin();
 
+				if (_size + n > _capacity)
+					reallocate(grow(_size + n));
 				this->resize(this->_size + n);
 				iterator end = this->end();
 				position = this->begin() + shift;
@@ -628,16 +640,25 @@ namespace ft
 					++tmp;
 					++n;
 				}
+				if (n == 0)
+					return;
 				if ((_size + n) > _capacity)
-					reallocate(_size + n);
+					reallocate(grow(_size + n));
+				for (size_type i = _size; i > static_cast<size_type>(shift); i--)
+				{
+					if (i - 1 + n >= _size)
+						_alloc.construct(&_head[i - 1 + n], _head[i - 1]);
+					else
+						_head[i - 1 + n] = _head[i - 1];
+				}
+				for (size_type i = shift; first != last; ++first, ++i)
+				{
+					if (i < _size)
+						_head[i] = *first;
+					else
+						_alloc.construct(&_head[i], *first);
+				}
 				_size += n;
-				iterator it(&_head[_size - n]);
-				iterator insert_pos(&_head[shift]);
-				iterator it_end = this->end();
-				while (it >= insert_pos)
-					*--it_end = *--it;
-				while (first != last)
-					_alloc.construct(&(*insert_pos++), *first++);
 			}
 
 			/**
@@ -729,22 +750,41 @@ namespace ft
 		private:
 
 			/**
-			 * @brief 
+			 * @brief Computes the capacity to reallocate to when new_size
+			 * elements no longer fit, as decided by the growth policy.
+			 * @throw If new_size is greater than the maximum size
+			 * (vector::max_size), a length_error exception is thrown.
 			*/
 			size_type grow(size_type new_size)
 			{
-				size_type		growth_factor = 2;
-
-				size_type	new_capacity = (_capacity > 0 ? _capacity : 1);
-				while (new_capacity < new_size)
-					new_capacity *= growth_factor;
+				if (new_size > this->max_size())
+					throw std::length_error("resized above max_size");
+				size_type	new_capacity = growth_policy::next_capacity(_capacity,
+					new_size, sizeof(value_type));
+				if (new_capacity < new_size || new_capacity > this->max_size())
+					new_capacity = this->max_size();
 				return (new_capacity);
 			}
 
 			/**
-			 * @brief 
+			 * @brief Moves the elements to a buffer of new_capacity elements.
+			 * When the elements are trivially relocatable and the allocator
+			 * can resize a block, the buffer is resized in place instead.
 			*/
 			void reallocate(size_type new_capacity)
+			{
+				reallocate(new_capacity, bool_constant<
+					is_trivially_relocatable<value_type>::value
+					&& allocator_can_reallocate<allocator_type>::value>());
+			}
+
+			void reallocate(size_type new_capacity, true_type)
+			{
+				_head = _alloc.reallocate(_head, _capacity, new_capacity);
+				_capacity = new_capacity;
+			}
+
+			void reallocate(size_type new_capacity, false_type)
 			{
 				pointer new_vector = _alloc.allocate(new_capacity);
 				for (size_type i = 0; i < _size; i++)
@@ -771,45 +811,47 @@ namespace ft
 ** -------------------------------- OVERLOADS ----------------------------------
 */
 
-		template <class T, class Alloc>
-		bool operator==(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator==(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			if (lhs.size() != rhs.size())
 				return (false);
 			return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 		}
-		template <class T, class Alloc>
-		bool operator!=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator!=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			return !(lhs == rhs);
 		}
-		template <class T, class Alloc>
-		bool operator<(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator<(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
 				rhs.begin(), rhs.end()));
 		}
-		template <class T, class Alloc>
-		bool operator<=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator<=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			return !(rhs < lhs);
 		}
-		template <class T, class Alloc>
-		bool operator>(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator>(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			return (rhs < lhs);
 		}
-		template <class T, class Alloc>
-		bool operator>=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+		template <class T, class Alloc, class Growth>
+		bool operator>=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs)
 		{
 			return !(lhs < rhs);
 		}
 
-		template <class T, class Alloc>
-		void swap(vector<T,Alloc>& x, vector<T,Alloc>& y)
+		template <class T, class Alloc, class Growth>
+		void swap(vector<T,Alloc,Growth>& x, vector<T,Alloc,Growth>& y)
 		{
 			x.swap(y);
 		}
 }
 
+# include "dynamic_bitset.hpp"
+
 #endif /* ******************************************************** VECTOR_HPP */
\ No newline at end of file
@@ -14,6 +14,10 @@
 # define VECTOR_ITERATORS_HPP
 
 # include <stddef.h>
+# include <iterator>
+# include <string.h>
+# include "type_traits.hpp"
+# include "simd.hpp"
 
 namespace ft
 {
@@ -354,6 +358,102 @@ namespace ft
 			}
 			const_pointer operator->() const { return (&this->operator*()); }
 	};
+
+/*
+** -------------------------- CONTIGUOUS COMPARISONS ---------------------------
+*/
+
+	/*
+	** Vector iterators walk contiguous storage, so ft::equal and
+	** ft::lexicographical_compare over two ranges of them compare memory
+	** directly when the elements are integral: their object representation
+	** has no padding and two elements are equal exactly when their bytes are.
+	** These overloads are more specialised than the generic ones in
+	** utils.hpp, and are picked by the comparison operators of the vectors.
+	*/
+
+	template <class T>
+	bool	contiguous_equal(const T* a, const T* b, size_t n, true_type)
+	{
+		return (n == 0 || memcmp(a, b, n * sizeof(T)) == 0);
+	}
+
+	template <class T>
+	bool	contiguous_equal(const T* a, const T* b, size_t n, false_type)
+	{
+		for (size_t i = 0; i < n; i++)
+			if (a[i] != b[i])
+				return (false);
+		return (true);
+	}
+
+	/**
+	 * @brief Finds the first differing element with simd::mismatch, then
+	 * compares that element only.
+	*/
+	template <class T>
+	bool	contiguous_less(const T* a, size_t n1, const T* b, size_t n2,
+		true_type)
+	{
+		size_t	n = (n1 < n2 ? n1 : n2);
+		size_t	i = (n ? simd::mismatch(a, b, n * sizeof(T)) / sizeof(T) : 0);
+
+		if (i == n)
+			return (n1 < n2);
+		return (a[i] < b[i]);
+	}
+
+	template <class T>
+	bool	contiguous_less(const T* a, size_t n1, const T* b, size_t n2,
+		false_type)
+	{
+		size_t	n = (n1 < n2 ? n1 : n2);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (a[i] < b[i])
+				return (true);
+			if (b[i] < a[i])
+				return (false);
+		}
+		return (n1 < n2);
+	}
+
+	template <class T>
+	static bool	equal(Vector_iterator<T> first1, Vector_iterator<T> last1,
+		Vector_iterator<T> first2)
+	{
+		return (contiguous_equal<T>(first1.operator->(), first2.operator->(),
+			last1 - first1, bool_constant<is_integral<T>::value>()));
+	}
+
+	template <class T>
+	static bool	equal(Vector_const_iterator<T> first1,
+		Vector_const_iterator<T> last1, Vector_const_iterator<T> first2)
+	{
+		return (contiguous_equal<T>(first1.operator->(), first2.operator->(),
+			last1 - first1, bool_constant<is_integral<T>::value>()));
+	}
+
+	template <class T>
+	static bool	lexicographical_compare(Vector_iterator<T> first1,
+		Vector_iterator<T> last1, Vector_iterator<T> first2,
+		Vector_iterator<T> last2)
+	{
+		return (contiguous_less<T>(first1.operator->(), last1 - first1,
+			first2.operator->(), last2 - first2,
+			bool_constant<is_integral<T>::value>()));
+	}
+
+	template <class T>
+	static bool	lexicographical_compare(Vector_const_iterator<T> first1,
+		Vector_const_iterator<T> last1, Vector_const_iterator<T> first2,
+		Vector_const_iterator<T> last2)
+	{
+		return (contiguous_less<T>(first1.operator->(), last1 - first1,
+			first2.operator->(), last2 - first2,
+			bool_constant<is_integral<T>::value>()));
+	}
 }
 
 #endif /* ********************************************** VECTOR_ITERATORS_HPP */
\ No newline at end of file